@@ -14,6 +14,9 @@
  */
 
 #include "Depot.h"
+#include "RouteSolver.h"
+#include "RouteKernels.h"
+#include "NameIndex.h"
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -23,17 +26,48 @@
 #include <random>    // For random engine
 #include <chrono>    // For time-based seed
 #include <limits>    // For numeric_limits
+#include <iomanip>   // For setprecision in the route report
+#include <algorithm> // For min
+#include <unordered_map>
 
 using namespace std;
 
 // Adds a drone to the vector
 void Depot::addDrone(Drone& d1) {
     drones.push_back(d1);
+    nameIndex.insert(d1.getName(), drones.size() - 1);
+    idIndex.insert(make_pair(d1.getID(), drones.size() - 1));
+    taskIndex.addDrone(d1, drones.size() - 1);
+}
+
+// Appends many drones; one index rebuild instead of a sorted insert each
+void Depot::addDrones(const vector<Drone>& batch) {
+    for (size_t i = 0; i < batch.size(); ++i) {
+        drones.push_back(batch[i]);
+    }
+    reindexFleet();
+}
+
+// Rebuilds every index after drones change slots
+void Depot::reindexFleet() {
+    nameIndex.rebuild(drones);
+    taskIndex.rebuild(drones);
+    idIndex.clear();
+    for (int i = 0; i < drones.size(); ++i) {
+        idIndex.insert(make_pair(drones[i].getID(), i));
+    }
 }
 
 // Retrieves a reference to a drone at a specific index
 Drone& Depot::getDrone(int index) {
-    // This assumes index is valid; main program should check
+    // This assumes index is valid; main program should check.
+    // Un-shares the drone from any snapshot before handing out a reference
+    return drones.mut(index);
+}
+
+// Read-only access to a drone at a specific index
+const Drone& Depot::getDrone(int index) const {
+    // This assumes index is valid; callers must check
     return drones[index];
 }
 
@@ -62,10 +96,12 @@ void Depot::sortByName() {
             }
             
             if (shouldSwap) {
-                std::swap(drones[j], drones[j + 1]);
+                drones.swap(j, j + 1);
             }
         }
     }
+    // Slots moved; refresh the indexes
+    reindexFleet();
 }
 
 // Manually sorts the drone vector by ID (ascending)
@@ -75,10 +111,12 @@ void Depot::sortByID() {
         for (int j = 0; j < n - 1 - i; ++j) {
             // Compare IDs
             if (drones[j].getID() > drones[j + 1].getID()) {
-                std::swap(drones[j], drones[j + 1]);
+                drones.swap(j, j + 1);
             }
         }
     }
+    // Slots moved; refresh the indexes
+    reindexFleet();
 }
 
 // Manually sorts the drone vector by distance from origin (ascending)
@@ -88,10 +126,12 @@ void Depot::sortByPosition() {
         for (int j = 0; j < n - 1 - i; ++j) {
             // Compare distances
             if (drones[j].getDistanceToOrigin() > drones[j + 1].getDistanceToOrigin()) {
-                std::swap(drones[j], drones[j + 1]);
+                drones.swap(j, j + 1);
             }
         }
     }
+    // Slots moved; refresh the indexes
+    reindexFleet();
 }
 
 // --- Searching Implementations (Binary Search) ---
@@ -143,43 +183,205 @@ int Depot::searchDroneByID(int id) {
 // --- Drone Interaction Method Implementations ---
 
 // Swaps task data (tasks + task positions) between two drones
-void Depot::swapDroneData(int index1, int index2) {
-    int n = static_cast<int>(drones.size());
+bool Depot::swapDroneData(int index1, int index2) {
+    int n = drones.size();
     if (index1 < 0 || index1 >= n || index2 < 0 || index2 >= n) {
         cout << "Error: Invalid indices for swap." << endl;
-        return;
+        return false;
     }
     if (index1 == index2) {
         cout << "Swap skipped: indices are the same." << endl;
-        return;
+        return false;
     }
     // Use the overloaded operator- to swap only tasks and their positions
-    Drone t = drones[index1];
-    drones[index1] - drones[index2];
-    cout << "Swapped task data between drones " << index1 << " and " << index2 << "." << endl;
+    taskIndex.removeDrone(drones[index1], index1);
+    taskIndex.removeDrone(drones[index2], index2);
+    Drone& d1 = drones.mut(index1);
+    Drone& d2 = drones.mut(index2);
+    d1 - d2;
+    taskIndex.addDrone(drones[index1], index1);
+    taskIndex.addDrone(drones[index2], index2);
+    return true;
 }
 
 // Copies drone data from index1 to index2
-void Depot::copyDrone(int index1, int index2) {
+bool Depot::copyDrone(int index1, int index2) {
+    int n = drones.size();
+    if (index1 < 0 || index1 >= n || index2 < 0 || index2 >= n) {
+        cout << "Error: Invalid indices for copy." << endl;
+        return false;
+    }
     // Use the overloaded operator<<
-    drones[index2] << drones[index1];
+    nameIndex.remove(drones[index2].getName(), index2);
+    idIndex.erase(make_pair(drones[index2].getID(), index2));
+    taskIndex.removeDrone(drones[index2], index2);
+    drones.mut(index2) << drones[index1];
+    nameIndex.insert(drones[index2].getName(), index2);
+    idIndex.insert(make_pair(drones[index2].getID(), index2));
+    taskIndex.addDrone(drones[index2], index2);
+    return true;
 }
 
 // Inserts a new task into a specific drone's task list
-void Depot::insertDroneTask(int droneidx, int taskidx, string& task, int task_pos[2]) {
-    drones[droneidx].setTask(taskidx, task);
-    drones[droneidx].setTaskPosition(taskidx, 0, task_pos[0]);
-    drones[droneidx].setTaskPosition(taskidx, 1, task_pos[1]);
+bool Depot::insertDroneTask(int droneidx, int taskidx, string& task, int task_pos[2]) {
+    if (droneidx < 0 || droneidx >= drones.size()) {
+        cout << "Error: Invalid drone index for insert." << endl;
+        return false;
+    }
+    if (taskidx < 0 || taskidx >= 5) {
+        cout << "Error: Task index must be 0-4." << endl;
+        return false;
+    }
+    // Checked before any write so a rejected insert leaves the task as it was
+    if (!Drone::positionFits(task_pos[0]) || !Drone::positionFits(task_pos[1])) {
+        cout << "Error: Task position is outside the stored coordinate range." << endl;
+        return false;
+    }
+    taskIndex.removeDrone(drones[droneidx], droneidx);
+    Drone& d = drones.mut(droneidx);
+    d.setTask(taskidx, task);
+    d.setTaskPosition(taskidx, 0, task_pos[0]);
+    d.setTaskPosition(taskidx, 1, task_pos[1]);
+    taskIndex.addDrone(d, droneidx);
+    // Patch the kept route locally instead of recomputing it
+    d.repairRoute(taskidx);
+    return true;
+}
+
+// --- Batch Edits ---
+
+// Above this many renamed drones one name index rebuild beats per-drone updates
+static const int NAME_REBUILD_EDITS = 32;
+
+// Checks one batch edit against the fleet
+bool Depot::validateEdit(const DroneEdit& edit, int editNumber) const {
+    int n = drones.size();
+    bool firstOk = edit.index1 >= 0 && edit.index1 < n;
+    bool secondOk = edit.type == DroneEdit::INSERT_TASK || (edit.index2 >= 0 && edit.index2 < n);
+    if (!firstOk || !secondOk) {
+        cout << "Error: Edit " << editNumber << " has an invalid drone index." << endl;
+        return false;
+    }
+    if (edit.type == DroneEdit::SWAP_DATA && edit.index1 == edit.index2) {
+        cout << "Error: Edit " << editNumber << " swaps a drone with itself." << endl;
+        return false;
+    }
+    if (edit.type == DroneEdit::INSERT_TASK && (edit.taskIdx < 0 || edit.taskIdx >= 5)) {
+        cout << "Error: Edit " << editNumber << " has a task index outside 0-4." << endl;
+        return false;
+    }
+    if (edit.type == DroneEdit::INSERT_TASK
+        && (!Drone::positionFits(edit.taskPos[0]) || !Drone::positionFits(edit.taskPos[1]))) {
+        cout << "Error: Edit " << editNumber << " has a task position outside the stored coordinate range." << endl;
+        return false;
+    }
+    return true;
+}
+
+// Applies a validated batch: index entries of touched drones are removed
+// once before the edits and added once after, and each drone's kept route
+// is repaired (one changed task) or rebuilt (several) once at the end
+bool Depot::applyEdits(const vector<DroneEdit>& edits) {
+    for (size_t e = 0; e < edits.size(); ++e) {
+        if (!validateEdit(edits[e], static_cast<int>(e) + 1)) {
+            cout << "No edits applied." << endl;
+            return false;
+        }
+    }
+
+    // Drones whose tasks / names change during the batch
+    vector<int> touched, renamed;
+    for (size_t e = 0; e < edits.size(); ++e) {
+        if (edits[e].type == DroneEdit::SWAP_DATA) touched.push_back(edits[e].index1);
+        if (edits[e].type == DroneEdit::INSERT_TASK) {
+            touched.push_back(edits[e].index1);
+        } else {
+            touched.push_back(edits[e].index2);
+        }
+        if (edits[e].type == DroneEdit::COPY_DRONE) renamed.push_back(edits[e].index2);
+    }
+    sort(touched.begin(), touched.end());
+    touched.erase(unique(touched.begin(), touched.end()), touched.end());
+    sort(renamed.begin(), renamed.end());
+    renamed.erase(unique(renamed.begin(), renamed.end()), renamed.end());
+    bool rebuildNames = static_cast<int>(renamed.size()) > NAME_REBUILD_EDITS;
+
+    for (size_t i = 0; i < touched.size(); ++i) {
+        taskIndex.removeDrone(drones[touched[i]], touched[i]);
+    }
+    if (!rebuildNames) {
+        for (size_t i = 0; i < renamed.size(); ++i) {
+            nameIndex.remove(drones[renamed[i]].getName(), renamed[i]);
+        }
+    }
+    for (size_t i = 0; i < renamed.size(); ++i) {
+        idIndex.erase(make_pair(drones[renamed[i]].getID(), renamed[i]));
+    }
+
+    // Task slots inserted per drone (bit t = slot t); follows the route
+    // when data moves between drones
+    unordered_map<int, int> changedSlots;
+    for (size_t e = 0; e < edits.size(); ++e) {
+        const DroneEdit& edit = edits[e];
+        if (edit.type == DroneEdit::SWAP_DATA) {
+            Drone& d1 = drones.mut(edit.index1);
+            Drone& d2 = drones.mut(edit.index2);
+            d1 - d2;
+            std::swap(changedSlots[edit.index1], changedSlots[edit.index2]);
+        } else if (edit.type == DroneEdit::COPY_DRONE) {
+            drones.mut(edit.index2) << drones[edit.index1];
+            changedSlots[edit.index2] = changedSlots[edit.index1];
+        } else {
+            Drone& d = drones.mut(edit.index1);
+            d.setTask(edit.taskIdx, edit.task);
+            d.setTaskPosition(edit.taskIdx, 0, edit.taskPos[0]);
+            d.setTaskPosition(edit.taskIdx, 1, edit.taskPos[1]);
+            changedSlots[edit.index1] |= 1 << edit.taskIdx;
+        }
+    }
+
+    // Route maintenance, once per drone
+    for (unordered_map<int, int>::const_iterator it = changedSlots.begin(); it != changedSlots.end(); ++it) {
+        int mask = it->second;
+        if (mask == 0) continue;
+        Drone& d = drones.mut(it->first);
+        if ((mask & (mask - 1)) == 0) {
+            int slot = 0;
+            while (!(mask & (1 << slot))) ++slot;
+            d.repairRoute(slot);
+        } else {
+            d.resetRoute();
+        }
+    }
+
+    for (size_t i = 0; i < touched.size(); ++i) {
+        taskIndex.addDrone(drones[touched[i]], touched[i]);
+    }
+    if (rebuildNames) {
+        nameIndex.rebuild(drones);
+    } else {
+        for (size_t i = 0; i < renamed.size(); ++i) {
+            nameIndex.insert(drones[renamed[i]].getName(), renamed[i]);
+        }
+    }
+    for (size_t i = 0; i < renamed.size(); ++i) {
+        idIndex.insert(make_pair(drones[renamed[i]].getID(), renamed[i]));
+    }
+    return true;
 }
 
 // Sorts a specific drone's task list ascending
 void Depot::sortDroneDataAscending(int idx) {
-    drones[idx].sortByAscending();
+    taskIndex.removeDrone(drones[idx], idx);
+    drones.mut(idx).sortByAscending();
+    taskIndex.addDrone(drones[idx], idx);
 }
 
 // Sorts a specific drone's task list descending
 void Depot::sortDroneDataDescending(int idx) {
-    drones[idx].sortByDescending();
+    taskIndex.removeDrone(drones[idx], idx);
+    drones.mut(idx).sortByDescending();
+    taskIndex.addDrone(drones[idx], idx);
 }
 
 // --- Other Method Implementations ---
@@ -196,17 +398,133 @@ void Depot::randomizeOrder() {
         std::uniform_int_distribution<int> d(0, i);
         int j = d(e);
         // Swap drones[i] with drones[j]
-        std::swap(drones[i], drones[j]);
+        drones.swap(i, j);
+    }
+    // Slots moved; refresh the indexes
+    reindexFleet();
+}
+
+// --- What-If Snapshots ---
+
+// O(1) fork of the fleet; edits to it never touch this depot
+DepotSnapshot Depot::snapshot() const {
+    return DepotSnapshot(drones);
+}
+
+// Adopts a snapshot's fleet if the depot has not changed since it was taken
+bool Depot::commitSnapshot(const DepotSnapshot& snap) {
+    if (!drones.sameRoot(snap.base)) {
+        // Un-sharing without an edit (kept route upkeep, a non-const
+        // getDrone) moves the root too; only real drone changes conflict
+        vector<int> liveChanged;
+        drones.diff(snap.base, liveChanged);
+        if (!liveChanged.empty()) {
+            cout << "Error: Depot changed since the snapshot was taken; commit refused." << endl;
+            return false;
+        }
+    }
+    // Only the edited drones need their index entries replaced
+    vector<int> changed;
+    snap.drones.diff(snap.base, changed);
+    for (size_t i = 0; i < changed.size(); ++i) {
+        const Drone& before = drones[changed[i]];
+        nameIndex.remove(before.getName(), changed[i]);
+        idIndex.erase(make_pair(before.getID(), changed[i]));
+        taskIndex.removeDrone(before, changed[i]);
+    }
+    drones = snap.drones;
+    for (size_t i = 0; i < changed.size(); ++i) {
+        const Drone& after = drones[changed[i]];
+        nameIndex.insert(after.getName(), changed[i]);
+        idIndex.insert(make_pair(after.getID(), changed[i]));
+        taskIndex.addDrone(after, changed[i]);
+    }
+    return true;
+}
+
+// --- Name Index Queries ---
+
+// Exact name lookup through the name index
+int Depot::findDroneByName(const string& name) const {
+    return nameIndex.find(name);
+}
+
+// Exact ID lookup through the ID index
+int Depot::findDroneByID(int id) const {
+    set<pair<int, int> >::const_iterator it = idIndex.lower_bound(make_pair(id, -1));
+    if (it != idIndex.end() && it->first == id) {
+        return it->second;
+    }
+    return -1;
+}
+
+// Slots of drones whose name starts with prefix, in name order
+void Depot::findDronesByPrefix(const string& prefix, vector<int>& results) const {
+    results.clear();
+    nameIndex.findPrefix(prefix, results);
+}
+
+// Slots of drones whose name is within maxEdits edits of name
+void Depot::findDronesFuzzy(const string& name, int maxEdits, vector<int>& results) const {
+    results.clear();
+    nameIndex.findFuzzy(name, maxEdits, results);
+}
+
+// Displays one page of drones from a result list
+void Depot::displayDronePage(const vector<int>& results, int page, int pageSize, ostream& out) const {
+    int total = static_cast<int>(results.size());
+    int pages = (total + pageSize - 1) / pageSize;
+    if (total == 0) {
+        out << "No matching drones." << endl;
+        return;
+    }
+    if (page < 1 || page > pages) {
+        out << "Invalid page (1-" << pages << ")." << endl;
+        return;
+    }
+    int first = (page - 1) * pageSize;
+    int last = min(total, first + pageSize);
+    out << "Matches " << first + 1 << "-" << last << " of " << total
+        << " (page " << page << " of " << pages << ")" << endl;
+    for (int i = first; i < last; ++i) {
+        out << "[" << results[i] << "] ";
+        drones[results[i]].displayDrone(out);
+    }
+}
+
+// --- Task Index Queries ---
+
+// Every (drone, task slot) whose task name is exactly task
+void Depot::findDronesByTask(const string& task, vector<TaskPosting>& results) const {
+    taskIndex.findByName(task, results);
+}
+
+// Every (drone, task slot) whose position is within radius of (x, y)
+void Depot::findTasksNear(int x, int y, double radius, vector<TaskPosting>& results) const {
+    taskIndex.findWithinRadius(x, y, radius, results);
+}
+
+// Prints task postings, one line per matching task
+void Depot::printTaskPostings(const vector<TaskPosting>& results, ostream& out) const {
+    if (results.empty()) {
+        out << "No matching tasks." << endl;
+        return;
+    }
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Drone& d = drones[results[i].droneSlot];
+        int t = results[i].taskSlot;
+        out << "[" << results[i].droneSlot << "] " << d.getName() << ": " << t + 1 << ". "
+            << d.getTask(t) << " at (" << d.getTaskPosition(t, 0) << "," << d.getTaskPosition(t, 1) << ")" << endl;
     }
 }
 
 // Prints the names of all drones
-void Depot::printAllNames() {
-    cout << "--- Drone Roster ---" << endl;
-    for (size_t i = 0; i < drones.size(); ++i) {
-        cout << i << ": " << drones[i].getName() << endl;
+void Depot::printAllNames(ostream& out) {
+    out << "--- Drone Roster ---" << endl;
+    for (int i = 0; i < drones.size(); ++i) {
+        out << i << ": " << drones[i].getName() << endl;
     }
-    cout << "--------------------" << endl;
+    out << "--------------------" << endl;
 }
 
 // Writes the entire depot state to "Depot.txt"
@@ -221,76 +539,102 @@ void Depot::writeDepotToFile() {
     outFile << fixed;
     outFile.precision(2);
 
-    for (size_t i = 0; i < drones.size(); ++i) {
-        // Write standard drone info
-        outFile << "Drone: " << drones[i].getName() << " (ID=" << drones[i].getID() 
-                << ", Position=(" << drones[i].getInitPosition(0) << ", " 
-                << drones[i].getInitPosition(1) << "))" << endl;
-        outFile << "Tasks:" << endl;
-        for (int j = 0; j < 5; ++j) {
-            outFile << j + 1 << ". " << drones[i].getTask(j) << " at (" 
-                    << drones[i].getTaskPosition(j, 0) << "," 
-                    << drones[i].getTaskPosition(j, 1) << ")" << endl;
+    for (int i = 0; i < drones.size(); ++i) {
+        writeDroneRecord(drones[i], outFile);
+    }
+
+    outFile.close();
+}
+
+// Prints per-drone and fleet memory use of the drone records
+void Depot::printMemoryReport(ostream& out) const {
+    const int wideBytes = 12 * static_cast<int>(sizeof(int));
+    const int compactBytes = 12 * static_cast<int>(sizeof(int16_t));
+    long long n = drones.size();
+
+    // Coordinates that would not fit 16-bit storage
+    long long outOfRange = 0;
+    auto fits16 = [](int v) { return v >= -32768 && v <= 32767; };
+    for (int i = 0; i < drones.size(); ++i) {
+        const Drone& d = drones[i];
+        for (int k = 0; k < 2; ++k) {
+            if (!fits16(d.getInitPosition(k))) ++outOfRange;
         }
+        for (int t = 0; t < 5; ++t) {
+            for (int k = 0; k < 2; ++k) {
+                if (!fits16(d.getTaskPosition(t, k))) ++outOfRange;
+            }
+        }
+    }
 
-        // --- Bonus: Write Route Info ---
-        computeGreedyRoute(i, outFile);
-        computeOptimalRoute(i, outFile);
+    out << "--- Drone Memory Report ---" << endl;
+    out << "Drones: " << n << endl;
+    out << "Coordinate storage: " << 8 * (Drone::positionBytes() / 12) << "-bit"
+        << (Drone::positionBytes() == compactBytes ? " (compact)" : "") << endl;
+    out << "Bytes per drone record: " << sizeof(Drone) << " (coordinates " << Drone::positionBytes()
+        << ", excluding name/task string heap)" << endl;
+    if (Drone::positionBytes() == compactBytes) {
+        out << "Saved per drone vs 32-bit coordinates: " << wideBytes - compactBytes << " bytes" << endl;
+        out << "Saved for this fleet: " << n * (wideBytes - compactBytes) << " bytes" << endl;
+    } else {
+        out << "16-bit coordinates would save " << wideBytes - compactBytes << " bytes per drone ("
+            << n * (wideBytes - compactBytes) << " bytes for this fleet)" << endl;
+        out << "Coordinates outside the 16-bit range: " << outOfRange << endl;
+    }
+    out << "Fleet drone records: " << n * static_cast<long long>(sizeof(Drone)) << " bytes" << endl;
+    long long storedChars, wholeChars;
+    nameIndex.getStoredChars(storedChars, wholeChars);
+    out << "Name index: " << storedChars << " of " << wholeChars << " name characters stored (front-coded)" << endl;
+    out << "---------------------------" << endl;
+}
 
-        // Add blank line for readability
-        outFile << endl;
+// Writes one drone's record in Depot.txt format (caller sets number formatting)
+void Depot::writeDroneRecord(const Drone& d, ostream& out) {
+    // Write standard drone info
+    out << "Drone: " << d.getName() << " (ID=" << d.getID()
+        << ", Position=(" << d.getInitPosition(0) << ", "
+        << d.getInitPosition(1) << "))" << endl;
+    out << "Tasks:" << endl;
+    for (int j = 0; j < 5; ++j) {
+        out << j + 1 << ". " << d.getTask(j) << " at ("
+            << d.getTaskPosition(j, 0) << ","
+            << d.getTaskPosition(j, 1) << ")" << endl;
     }
 
-    outFile.close();
+    // --- Bonus: Write Route Info ---
+    computeGreedyRoute(d, out);
+    computeOptimalRoute(d, out);
+
+    // Add blank line for readability
+    out << endl;
 }
 
 // --- Bonus Method Implementations ---
 
-// Calculates distance between two 2D points
-double Depot::getTaskDistance(int pos1[2], int pos2[2]) {
-    double x_diff = static_cast<double>(pos1[0] - pos2[0]);
-    double y_diff = static_cast<double>(pos1[1] - pos2[1]);
-    return sqrt(pow(x_diff, 2) + pow(y_diff, 2));
+// Copies a drone's start and task positions into solver input arrays
+void Depot::getRoutePoints(const Drone& d, int startPos[2], int taskPos[5][2]) {
+    startPos[0] = d.getInitPosition(0);
+    startPos[1] = d.getInitPosition(1);
+    for (int i = 0; i < 5; ++i) {
+        taskPos[i][0] = d.getTaskPosition(i, 0);
+        taskPos[i][1] = d.getTaskPosition(i, 1);
+    }
 }
 
 // Computes and prints the greedy route for a drone
 void Depot::computeGreedyRoute(int droneIdx, ostream& out) {
-    Drone& d = drones[droneIdx];
-    int startPos[2] = {d.getInitPosition(0), d.getInitPosition(1)};
-    int currentPos[2];
-    currentPos[0] = startPos[0];
-    currentPos[1] = startPos[1];
+    computeGreedyRoute(drones[droneIdx], out);
+}
 
-    bool visited[5] = {false, false, false, false, false};
-    int route[5];
-    double totalDistance = 0.0;
+// Computes and prints the greedy route for a standalone drone
+void Depot::computeGreedyRoute(const Drone& d, ostream& out) {
+    int startPos[2];
+    int taskPos[5][2];
+    getRoutePoints(d, startPos, taskPos);
 
-    for (int i = 0; i < 5; ++i) {
-        double minDist = std::numeric_limits<double>::max();
-        int bestTaskIdx = -1;
-
-        // Find the closest unvisited task
-        for (int j = 0; j < 5; ++j) {
-            if (!visited[j]) {
-                int taskPos[2] = {d.getTaskPosition(j, 0), d.getTaskPosition(j, 1)};
-                double dist = getTaskDistance(currentPos, taskPos);
-                if (dist < minDist) {
-                    minDist = dist;
-                    bestTaskIdx = j;
-                }
-            }
-        }
-        
-        // Visit the closest task
-        totalDistance += minDist;
-        route[i] = bestTaskIdx;
-        visited[bestTaskIdx] = true;
-        currentPos[0] = d.getTaskPosition(bestTaskIdx, 0);
-        currentPos[1] = d.getTaskPosition(bestTaskIdx, 1);
-    }
-
-    // Add distance to return to start
-    totalDistance += getTaskDistance(currentPos, startPos);
+    // Nearest-neighbour tour from the shared solver
+    int route[5];
+    double totalDistance = solveGreedyRoute(startPos, taskPos, 5, route);
 
     // Print Greedy Route
     out << "[Greedy Route - closed]" << endl;
@@ -304,63 +648,20 @@ void Depot::computeGreedyRoute(int droneIdx, ostream& out) {
     out << "Total distance (greedy): " << totalDistance << endl;
 }
 
-// Recursive helper for finding the optimal (brute-force) route
-void Depot::findOptimalPermutation(int droneIdx, int taskIndices[], int k, double& minDistance, int bestPath[]) {
-    Drone& d = drones[droneIdx];
-    int startPos[2] = {d.getInitPosition(0), d.getInitPosition(1)};
-
-    // Base case: a full permutation is complete
-    if (k == 5) {
-        double currentDistance = 0.0;
-        int lastPos[2];
-
-        // Distance from start to first task
-        int firstTaskPos[2] = {d.getTaskPosition(taskIndices[0], 0), d.getTaskPosition(taskIndices[0], 1)};
-        currentDistance += getTaskDistance(startPos, firstTaskPos);
-        lastPos[0] = firstTaskPos[0];
-        lastPos[1] = firstTaskPos[1];
-
-        // Sum distances between tasks
-        for (int i = 1; i < 5; ++i) {
-            int currentTaskPos[2] = {d.getTaskPosition(taskIndices[i], 0), d.getTaskPosition(taskIndices[i], 1)};
-            currentDistance += getTaskDistance(lastPos, currentTaskPos);
-            lastPos[0] = currentTaskPos[0];
-            lastPos[1] = currentTaskPos[1];
-        }
-
-        // Add distance from last task back to start
-        currentDistance += getTaskDistance(lastPos, startPos);
-
-        // Check if this is the new best route
-        if (currentDistance < minDistance) {
-            minDistance = currentDistance;
-            for (int i = 0; i < 5; ++i) {
-                bestPath[i] = taskIndices[i];
-            }
-        }
-        return;
-    }
-
-    // Recursive step: generate permutations
-    for (int i = k; i < 5; ++i) {
-        std::swap(taskIndices[i], taskIndices[k]);
-        findOptimalPermutation(droneIdx, taskIndices, k + 1, minDistance, bestPath);
-        std::swap(taskIndices[i], taskIndices[k]); // Backtrack
-    }
+// Computes and prints the global optimal route for a drone
+void Depot::computeOptimalRoute(int droneIdx, ostream& out) {
+    computeOptimalRoute(drones[droneIdx], out);
 }
 
+// Computes and prints the global optimal route for a standalone drone
+void Depot::computeOptimalRoute(const Drone& d, ostream& out) {
+    int startPos[2];
+    int taskPos[5][2];
+    getRoutePoints(d, startPos, taskPos);
 
-// Computes and prints the global optimal route for a drone
-void Depot::computeOptimalRoute(int droneIdx, ostream& out) {
-    Drone& d = drones[droneIdx];
-    int startPos[2] = {d.getInitPosition(0), d.getInitPosition(1)};
-    
-    int taskIndices[5] = {0, 1, 2, 3, 4};
+    // Exact search with the kernel specialised for 5 tasks
     int bestPath[5];
-    double minDistance = std::numeric_limits<double>::max();
-
-    // Find the best permutation
-    findOptimalPermutation(droneIdx, taskIndices, 0, minDistance, bestPath);
+    double minDistance = solveOptimalRouteFixed(startPos, taskPos, 5, bestPath);
 
     // Print Optimal Route
     out << "[Global Optimal Route - closed]" << endl;
@@ -373,3 +674,132 @@ void Depot::computeOptimalRoute(int droneIdx, ostream& out) {
     out << " -> (" << startPos[0] << "," << startPos[1] << ")" << endl;
     out << "Total distance (optimal): " << minDistance << endl;
 }
+
+// Computes and prints a route with the named registry solver
+bool Depot::computeSolverRoute(int droneIdx, const string& solverName, ostream& out) {
+    const vector<RouteSolverEntry>& solvers = getRouteSolvers();
+    for (size_t s = 0; s < solvers.size(); ++s) {
+        if (solvers[s].name != solverName) continue;
+
+        const Drone& d = drones[droneIdx];
+        int startPos[2];
+        int taskPos[5][2];
+        getRoutePoints(d, startPos, taskPos);
+        int route[5];
+        double totalDistance = solvers[s].solve(startPos, taskPos, 5, route, nullptr);
+
+        out << "[" << solverName << " Route - closed]" << endl;
+        out << "Sequence (starting at (" << startPos[0] << "," << startPos[1] << ")):" << endl;
+        out << "(" << startPos[0] << "," << startPos[1] << ")";
+        for (int i = 0; i < 5; ++i) {
+            out << " -> (" << taskPos[route[i]][0] << "," << taskPos[route[i]][1] << ")";
+        }
+        out << " -> (" << startPos[0] << "," << startPos[1] << ")" << endl;
+        out << "Total distance (" << solverName << "): " << totalDistance << endl;
+        return true;
+    }
+    return false;
+}
+
+// Length of a drone's kept (incrementally repaired) route
+double Depot::getRepairedRouteLength(int droneIdx) {
+    // Only write (and un-share) when the route has to be built
+    if (!drones[droneIdx].hasRoute()) {
+        drones.mut(droneIdx).resetRoute();
+    }
+    return drones[droneIdx].getRouteLength();
+}
+
+// Length of a greedy route computed from scratch for the same drone
+double Depot::getGreedyRouteLength(int droneIdx) {
+    return getGreedyRouteLength(drones[droneIdx]);
+}
+
+// Length of a greedy route for a standalone drone
+double Depot::getGreedyRouteLength(const Drone& d) {
+    int startPos[2];
+    int taskPos[5][2];
+    getRoutePoints(d, startPos, taskPos);
+    int route[5];
+    return solveGreedyRoute(startPos, taskPos, 5, route);
+}
+
+// Length of the optimal route for a standalone drone
+double Depot::getOptimalRouteLength(const Drone& d) {
+    int startPos[2];
+    int taskPos[5][2];
+    getRoutePoints(d, startPos, taskPos);
+    int bestPath[5];
+    return solveOptimalRouteFixed(startPos, taskPos, 5, bestPath);
+}
+
+// Prints the kept route next to a from-scratch greedy route
+void Depot::printRouteDrift(int droneIdx, ostream& out) {
+    double repaired = getRepairedRouteLength(droneIdx);
+    double scratch = getGreedyRouteLength(droneIdx);
+    const Drone& d = drones[droneIdx];
+
+    out << "[Kept Route - closed]" << endl;
+    out << "(" << d.getInitPosition(0) << "," << d.getInitPosition(1) << ")";
+    for (int i = 0; i < 5; ++i) {
+        int taskIdx = d.getRouteStop(i);
+        out << " -> (" << d.getTaskPosition(taskIdx, 0) << "," << d.getTaskPosition(taskIdx, 1) << ")";
+    }
+    out << " -> (" << d.getInitPosition(0) << "," << d.getInitPosition(1) << ")" << endl;
+    out << "Total distance (repaired): " << repaired << endl;
+    out << "Total distance (greedy from scratch): " << scratch << endl;
+    out << "Drift: " << (scratch > 0.0 ? 100.0 * (repaired - scratch) / scratch : 0.0) << "%" << endl;
+}
+
+// Runs every registered solver on every drone and writes a CSV comparison.
+// One row per (drone, solver), then one "ALL" row per solver with fleet totals.
+void Depot::writeRouteReport(ostream& out) {
+    const vector<RouteSolverEntry>& solvers = getRouteSolvers();
+    int numSolvers = static_cast<int>(solvers.size());
+    vector<double> fleetLength(numSolvers, 0.0);
+    vector<double> fleetMicros(numSolvers, 0.0);
+    vector<long long> fleetEvaluations(numSolvers, 0);
+    double fleetBest = 0.0;
+
+    out << "drone_index,name,id,solver,tasks,length,gap_percent,wall_us,evaluations" << endl;
+    out << fixed;
+
+    vector<double> length(numSolvers);
+    vector<double> micros(numSolvers);
+    vector<long long> evaluations(numSolvers);
+    for (int i = 0; i < drones.size(); ++i) {
+        int startPos[2];
+        int taskPos[5][2];
+        getRoutePoints(drones[i], startPos, taskPos);
+
+        // Solve with each solver; the shortest tour is the best known
+        double best = std::numeric_limits<double>::max();
+        for (int s = 0; s < numSolvers; ++s) {
+            int order[5];
+            auto t0 = std::chrono::steady_clock::now();
+            length[s] = solvers[s].solve(startPos, taskPos, 5, order, &evaluations[s]);
+            auto t1 = std::chrono::steady_clock::now();
+            micros[s] = std::chrono::duration<double, std::micro>(t1 - t0).count();
+            if (length[s] < best) best = length[s];
+        }
+
+        for (int s = 0; s < numSolvers; ++s) {
+            double gap = (best > 0.0) ? 100.0 * (length[s] - best) / best : 0.0;
+            out << i << "," << drones[i].getName() << "," << drones[i].getID() << ","
+                << solvers[s].name << ",5," << setprecision(2) << length[s] << ","
+                << gap << "," << micros[s] << "," << evaluations[s] << endl;
+            fleetLength[s] += length[s];
+            fleetMicros[s] += micros[s];
+            fleetEvaluations[s] += evaluations[s];
+        }
+        fleetBest += best;
+    }
+
+    // Fleet-wide aggregates: gap is total length versus sum of per-drone bests
+    for (int s = 0; s < numSolvers; ++s) {
+        double gap = (fleetBest > 0.0) ? 100.0 * (fleetLength[s] - fleetBest) / fleetBest : 0.0;
+        out << "ALL,fleet,," << solvers[s].name << "," << 5 * drones.size() << ","
+            << setprecision(2) << fleetLength[s] << "," << gap << ","
+            << fleetMicros[s] << "," << fleetEvaluations[s] << endl;
+    }
+}
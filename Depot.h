@@ -12,30 +12,62 @@
 
 #include <vector>
 #include <string>
+#include <iostream>
+#include <set>
+#include <utility>
 #include "Drone.h"
+#include "DroneStore.h"
+#include "DepotSnapshot.h"
+#include "NameIndex.h"
+#include "TaskIndex.h"
 
 using namespace std;
 
+// One edit in a batch for Depot::applyEdits()
+struct DroneEdit {
+    enum Type { SWAP_DATA, COPY_DRONE, INSERT_TASK };
+    Type type;
+    int index1;      // SWAP: first drone; COPY: source; INSERT: drone
+    int index2;      // SWAP: second drone; COPY: destination (unused by INSERT)
+    int taskIdx;     // INSERT: task slot 0-4
+    string task;     // INSERT: task name
+    int taskPos[2];  // INSERT: task position
+};
+
 // Depot class definition
 class Depot {
 private:
-    // Private attribute for the fleet
-    vector<Drone> drones;
+    // Private attribute for the fleet (copy-on-write, so snapshots are O(1))
+    DroneStore drones;
+    // Sorted name -> slot index, kept in step with every change to the fleet
+    // made through Depot (names edited through getDrone() are not tracked)
+    NameIndex nameIndex;
+    // Task name -> (drone, slot) postings plus a grid over task positions
+    TaskIndex taskIndex;
+    // (ID, slot) pairs in ID order, kept in step like nameIndex
+    set<pair<int, int> > idIndex;
+
+    // Rebuilds every index after drones change slots
+    void reindexFleet();
+    // Checks one batch edit against the fleet; prints why it is invalid
+    bool validateEdit(const DroneEdit& edit, int editNumber) const;
 
     // --- Bonus Helper Methods ---
-    // Calculates distance between two 2D points
-    double getTaskDistance(int pos1[2], int pos2[2]);
-    // Recursive helper for finding the optimal (brute-force) route
-    void findOptimalPermutation(int droneIdx, int taskIndices[], int k, double& minDistance, int bestPath[]);
+    // Copies a drone's start and task positions into solver input arrays
+    static void getRoutePoints(const Drone& d, int startPos[2], int taskPos[5][2]);
 
 public:
     // --- Core Methods ---
     // Adds a drone to the vector
     void addDrone(Drone& d1);
+    // Appends many drones, then rebuilds the indexes once (bulk loads)
+    void addDrones(const vector<Drone>& batch);
     // Retrieves a reference to a drone at a specific index
     Drone& getDrone(int index);
     // Gets the total number of drones in the depot
     int getNumDrones() const;
+    // Read-only access for concurrent readers (no index checks)
+    const Drone& getDrone(int index) const;
 
     // --- Sorting Methods ---
     // Manually sorts the drone vector by name
@@ -51,13 +83,46 @@ public:
     // Binary searches for a drone by ID (must sort first)
     int searchDroneByID(int id);
 
+    // --- What-If Snapshots ---
+    // Forks the fleet in O(1); edit, diff and compare routes on the snapshot
+    DepotSnapshot snapshot() const;
+    // Makes a snapshot's edits live; refused (false) if any drone in the
+    // depot changed after the snapshot was taken. Discarding is just
+    // dropping the snapshot
+    bool commitSnapshot(const DepotSnapshot& snap);
+
+    // --- Name Index Queries (no fleet re-sort) ---
+    // Slot of a drone with exactly this name (lowest slot on ties), or -1
+    int findDroneByName(const string& name) const;
+    // Slot of a drone with this ID (lowest slot on ties), or -1
+    int findDroneByID(int id) const;
+    // Slots of drones whose name starts with prefix, in name order
+    void findDronesByPrefix(const string& prefix, vector<int>& results) const;
+    // Slots of drones whose name is within maxEdits edits of name
+    void findDronesFuzzy(const string& name, int maxEdits, vector<int>& results) const;
+    // Displays page (1-based) of pageSize drones from a result list
+    void displayDronePage(const vector<int>& results, int page, int pageSize, ostream& out) const;
+
+    // --- Task Index Queries ---
+    // Every (drone, task slot) whose task name is exactly task
+    void findDronesByTask(const string& task, vector<TaskPosting>& results) const;
+    // Every (drone, task slot) whose position is within radius of (x, y)
+    void findTasksNear(int x, int y, double radius, vector<TaskPosting>& results) const;
+    // Prints task postings as "[drone] name: slot. task at (x,y)"
+    void printTaskPostings(const vector<TaskPosting>& results, ostream& out) const;
+
     // --- Drone Interaction Methods ---
-    // Swaps task data between two drones
-    void swapDroneData(int index1, int index2);
-    // Copies drone data from index1 to index2
-    void copyDrone(int index1, int index2);
-    // Inserts a new task into a specific drone's task list
-    void insertDroneTask(int droneidx, int taskidx, string& task, int task_pos[2]);
+    // Swaps task data between two drones (false on bad or equal indices);
+    // prints only errors, so the caller reports success
+    bool swapDroneData(int index1, int index2);
+    // Copies drone data from index1 to index2 (false on bad indices)
+    bool copyDrone(int index1, int index2);
+    // Inserts a new task into a specific drone's task list (false on bad indices)
+    bool insertDroneTask(int droneidx, int taskidx, string& task, int task_pos[2]);
+    // Validates every edit, then applies them all in order with index and
+    // route maintenance done once per touched drone. Nothing is applied if
+    // any edit is invalid
+    bool applyEdits(const vector<DroneEdit>& edits);
 
     // --- Drone Data Sorting ---
     // Sorts a specific drone's task list ascending
@@ -68,16 +133,39 @@ public:
     // --- Other Methods ---
     // Manually shuffles the order of drones in the vector
     void randomizeOrder();
-    // Prints the names of all drones
-    void printAllNames();
+    // Prints the names of all drones (to cout unless out is given)
+    void printAllNames(ostream& out = cout);
     // Writes the entire depot state to "Depot.txt"
     void writeDepotToFile();
+    // Writes one drone's Depot.txt record (info, tasks, both routes) to out
+    static void writeDroneRecord(const Drone& d, ostream& out);
+    // Prints bytes per drone, coordinate storage mode and bytes saved by
+    // 16-bit coordinates (DRONE_COMPACT_POSITIONS) for this fleet
+    void printMemoryReport(ostream& out) const;
 
     // --- Bonus Route Optimization Methods ---
     // Computes and prints the greedy route for a drone
     void computeGreedyRoute(int droneIdx, ostream& out);
     // Computes and prints the global optimal route for a drone
     void computeOptimalRoute(int droneIdx, ostream& out);
+    // Same as above for a drone that is not stored in a Depot (e.g. streaming)
+    static void computeGreedyRoute(const Drone& d, ostream& out);
+    static void computeOptimalRoute(const Drone& d, ostream& out);
+    // Computes and prints a route with any registered solver (by name);
+    // false if no solver has that name
+    bool computeSolverRoute(int droneIdx, const string& solverName, ostream& out);
+    // Length of the drone's kept route, repaired in place on task inserts
+    double getRepairedRouteLength(int droneIdx);
+    // Length of a greedy route recomputed from scratch (for drift checks)
+    double getGreedyRouteLength(int droneIdx);
+    // Route lengths for a standalone drone (used by what-if comparisons)
+    static double getGreedyRouteLength(const Drone& d);
+    static double getOptimalRouteLength(const Drone& d);
+    // Prints the kept route and its drift from a from-scratch greedy route
+    void printRouteDrift(int droneIdx, ostream& out);
+    // Runs every registered route solver on each drone; writes a CSV report
+    // of length, gap to best, wall time and evaluations plus fleet totals
+    void writeRouteReport(ostream& out);
 };
 
 #endif //DEPOT_H
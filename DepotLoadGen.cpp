@@ -0,0 +1,207 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * Authors: Andy, Patrick, Kaicheng
+ * File: DepotLoadGen.cpp
+ * Purpose:
+ *   Standalone load generator for the "--serve" daemon (DepotServer). Each
+ *   client thread opens one connection, keeps up to <depth> requests in
+ *   flight, and times every request from send to the end of its response.
+ *   Prints throughput and latency percentiles.
+ *
+ * Usage:
+ *   DepotLoadGen <socket> [requests] [depth] [clients] [read|mixed]
+ *   "mixed" makes every 10th request a SWAP edit; "read" (default) sends
+ *   only COUNT/GET/GREEDY/OPTIMAL.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+// Opens a connection to the daemon; returns -1 on failure
+int connectToServer(const string& path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Sends the whole string; false if the connection failed
+bool sendAll(int fd, const string& data) {
+    size_t done = 0;
+    while (done < data.size()) {
+        ssize_t sent = send(fd, data.data() + done, data.size() - done, MSG_NOSIGNAL);
+        if (sent <= 0) return false;
+        done += sent;
+    }
+    return true;
+}
+
+// Incremental reader for "OK|ERR <bytes>\n<payload>" responses
+class ResponseReader {
+private:
+    int fd;
+    string buffer;
+
+public:
+    explicit ResponseReader(int fd) : fd(fd) {}
+
+    // Blocks until one full response arrives; returns false on EOF or error
+    bool next(bool& ok, string& payload) {
+        while (true) {
+            size_t newline = buffer.find('\n');
+            if (newline != string::npos) {
+                size_t space = buffer.find(' ');
+                size_t length = strtoul(buffer.c_str() + space + 1, nullptr, 10);
+                if (buffer.size() >= newline + 1 + length) {
+                    ok = buffer.compare(0, 2, "OK") == 0;
+                    payload = buffer.substr(newline + 1, length);
+                    buffer.erase(0, newline + 1 + length);
+                    return true;
+                }
+            }
+            char chunk[65536];
+            ssize_t got = recv(fd, chunk, sizeof(chunk), 0);
+            if (got <= 0) return false;
+            buffer.append(chunk, got);
+        }
+    }
+};
+
+// Builds the i-th request of the mix
+string makeRequest(long long i, int numDrones, bool mixed) {
+    int idx = static_cast<int>(i % numDrones);
+    if (mixed && i % 10 == 9 && numDrones > 1) {
+        int a = static_cast<int>((i / 10) % numDrones);
+        return "SWAP " + to_string(a) + " " + to_string((a + 1) % numDrones) + "\n";
+    }
+    switch (i % 4) {
+    case 0: return "GET " + to_string(idx) + "\n";
+    case 1: return "GREEDY " + to_string(idx) + "\n";
+    case 2: return "OPTIMAL " + to_string(idx) + "\n";
+    default: return "COUNT\n";
+    }
+}
+
+// One client connection: pipelines `requests` requests at `depth` in flight
+void runClient(const string& path, long long requests, int depth, int numDrones, bool mixed,
+               vector<double>& latenciesUs, long long& errors) {
+    int fd = connectToServer(path);
+    if (fd < 0) {
+        errors = requests;
+        return;
+    }
+    ResponseReader reader(fd);
+    deque<Clock::time_point> inFlight;
+    long long sent = 0;
+    long long received = 0;
+    errors = 0;
+
+    while (received < requests) {
+        // Top up the pipeline in one write
+        string batch;
+        while (sent < requests && static_cast<int>(inFlight.size()) < depth) {
+            batch += makeRequest(sent++, numDrones, mixed);
+            inFlight.push_back(Clock::now());
+        }
+        if (!batch.empty() && !sendAll(fd, batch)) break;
+
+        bool ok;
+        string payload;
+        if (!reader.next(ok, payload)) break;
+        latenciesUs.push_back(chrono::duration<double, micro>(Clock::now() - inFlight.front()).count());
+        inFlight.pop_front();
+        if (!ok) ++errors;
+        ++received;
+    }
+    errors += requests - received;
+    close(fd);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Usage: " << argv[0] << " <socket> [requests] [depth] [clients] [read|mixed]\n";
+        return 1;
+    }
+    string path = argv[1];
+    long long requests = (argc >= 3) ? atoll(argv[2]) : 100000;
+    int depth = (argc >= 4) ? atoi(argv[3]) : 32;
+    int clients = (argc >= 5) ? atoi(argv[4]) : 1;
+    bool mixed = (argc >= 6) && string(argv[5]) == "mixed";
+    if (requests < 1 || depth < 1 || clients < 1) {
+        cout << "Invalid arguments.\n";
+        return 1;
+    }
+
+    // Ask for the fleet size so requests only use valid indices
+    int fd = connectToServer(path);
+    if (fd < 0) {
+        cout << "Error: Could not connect to " << path << endl;
+        return 1;
+    }
+    ResponseReader reader(fd);
+    bool ok = false;
+    string payload;
+    if (!sendAll(fd, "COUNT\n") || !reader.next(ok, payload) || !ok || atoi(payload.c_str()) < 1) {
+        cout << "Error: Server has no drones." << endl;
+        close(fd);
+        return 1;
+    }
+    int numDrones = atoi(payload.c_str());
+    close(fd);
+
+    vector<vector<double> > latencies(clients);
+    vector<long long> errors(clients, 0);
+    vector<thread> threads;
+    long long perClient = requests / clients;
+    Clock::time_point start = Clock::now();
+    for (int c = 0; c < clients; ++c) {
+        threads.emplace_back(runClient, path, perClient, depth, numDrones, mixed,
+                             ref(latencies[c]), ref(errors[c]));
+    }
+    for (size_t c = 0; c < threads.size(); ++c) {
+        threads[c].join();
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+    vector<double> all;
+    long long totalErrors = 0;
+    for (int c = 0; c < clients; ++c) {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        totalErrors += errors[c];
+    }
+    if (all.empty()) {
+        cout << "No responses received." << endl;
+        return 1;
+    }
+    sort(all.begin(), all.end());
+    auto percentile = [&](double p) { return all[static_cast<size_t>(p * (all.size() - 1))]; };
+
+    cout.setf(ios::fixed);
+    cout.precision(1);
+    cout << "Requests:   " << all.size() << " (" << totalErrors << " errors), "
+         << clients << " client(s), depth " << depth << "\n";
+    cout << "Throughput: " << all.size() / seconds << " req/s\n";
+    cout << "Latency us: p50 " << percentile(0.50) << "  p90 " << percentile(0.90)
+         << "  p99 " << percentile(0.99) << "  max " << all.back() << "\n";
+    return 0;
+}
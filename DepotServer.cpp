@@ -0,0 +1,483 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * Authors: Andy, Patrick, Kaicheng
+ * File: DepotServer.cpp
+ * Purpose:
+ *   Implements DepotServer: a poll()-based event loop over a Unix domain
+ *   socket, a worker pool for read-only requests, and the request handlers.
+ *
+ * Notes:
+ *   - Requests on one connection are started in order. A read-only request
+ *     is dispatched as soon as it is parsed; an edit waits until every
+ *     earlier request on its connection has finished, then runs on the loop
+ *     thread. That keeps pipelined results identical to one-at-a-time use.
+ *   - Workers hand results back through a queue and a byte on a self-pipe,
+ *     which wakes poll() without any timeout polling.
+ *   - Edits are validated here before calling Depot, so nothing is printed
+ *     to the daemon's stdout while the exclusive lock is held.
+ *   - A client that half-closes still gets every reply: its socket stays
+ *     open until outBuffer drains, and it is only polled for POLLOUT.
+ */
+
+#include "DepotServer.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+// Builds "OK <bytes>\n<payload>" or "ERR <bytes>\n<payload>"
+string frameResponse(bool ok, const string& payload) {
+    return (ok ? "OK " : "ERR ") + to_string(payload.size()) + "\n" + payload;
+}
+
+// Switches a descriptor to non-blocking mode
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+} // namespace
+
+// Constructor: the socket is created by run()
+DepotServer::DepotServer(Depot& depot, const string& socketPath, int numWorkers)
+    : depot(depot), socketPath(socketPath), numWorkers(numWorkers > 0 ? numWorkers : 1),
+      listenFd(-1), running(false), nextConnId(0) {
+    wakePipe[0] = wakePipe[1] = -1;
+}
+
+// Destructor: stops workers and releases the socket file
+DepotServer::~DepotServer() {
+    {
+        lock_guard<mutex> guard(jobsLock);
+        running = false;
+    }
+    jobsReady.notify_all();
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+    for (map<long long, Connection>::iterator it = connections.begin(); it != connections.end(); ++it) {
+        close(it->second.fd);
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+        unlink(socketPath.c_str());
+    }
+    if (wakePipe[0] >= 0) close(wakePipe[0]);
+    if (wakePipe[1] >= 0) close(wakePipe[1]);
+}
+
+// Binds the socket and runs the event loop until stop()
+bool DepotServer::run() {
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        cout << "Error: Socket path too long: " << socketPath << endl;
+        return false;
+    }
+    strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    if (pipe(wakePipe) != 0 || !setNonBlocking(wakePipe[0]) || !setNonBlocking(wakePipe[1])) {
+        cout << "Error: Could not create wake pipe." << endl;
+        return false;
+    }
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        cout << "Error: Could not create socket." << endl;
+        return false;
+    }
+    unlink(socketPath.c_str()); // remove a stale socket from an earlier run
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listenFd, 64) != 0) {
+        cout << "Error: Could not listen on " << socketPath << ": " << strerror(errno) << endl;
+        return false;
+    }
+    setNonBlocking(listenFd);
+
+    running = true;
+    for (int i = 0; i < numWorkers; ++i) {
+        workers.emplace_back(&DepotServer::workerLoop, this);
+    }
+
+    vector<pollfd> fds;
+    vector<long long> fdOwner; // connection id per pollfd entry (-1 for ours)
+    while (running) {
+        fds.clear();
+        fdOwner.clear();
+        fds.push_back({ wakePipe[0], POLLIN, 0 });
+        fdOwner.push_back(-1);
+        fds.push_back({ listenFd, POLLIN, 0 });
+        fdOwner.push_back(-1);
+        for (map<long long, Connection>::iterator it = connections.begin(); it != connections.end(); ++it) {
+            const Connection& conn = it->second;
+            short events = conn.peerClosed ? 0 : POLLIN;
+            if (!conn.outBuffer.empty()) events |= POLLOUT;
+            // A hung-up client still reports POLLHUP; leave it out until it has output
+            fds.push_back({ events != 0 ? conn.fd : -1, events, 0 });
+            fdOwner.push_back(it->first);
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            cout << "Error: poll failed: " << strerror(errno) << endl;
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            char drain[256];
+            while (read(wakePipe[0], drain, sizeof(drain)) > 0) {
+            }
+            collectCompletions();
+        }
+        if (fds[1].revents & POLLIN) {
+            acceptClients();
+        }
+        for (size_t i = 2; i < fds.size(); ++i) {
+            map<long long, Connection>::iterator it = connections.find(fdOwner[i]);
+            if (it == connections.end()) continue;
+            if (it->second.peerClosed) {
+                // Nothing more to read; only flush what is left
+                if (fds[i].revents & (POLLOUT | POLLHUP | POLLERR)) {
+                    writeClient(it->second);
+                }
+                continue;
+            }
+            if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                readClient(it->first, it->second);
+            }
+            if (fds[i].revents & POLLOUT) {
+                writeClient(it->second);
+            }
+        }
+
+        // Drop clients that hung up once every response has been sent
+        for (map<long long, Connection>::iterator it = connections.begin(); it != connections.end();) {
+            Connection& conn = it->second;
+            long long id = it->first;
+            ++it;
+            if (conn.outstanding != 0 || !conn.pending.empty() || !conn.outBuffer.empty()) continue;
+            if (conn.peerClosed) {
+                closeClient(id);
+            } else if (conn.rejected && !conn.sentEof) {
+                // Closing with unread input would reset the client before it
+                // reads our replies; send EOF and wait for it to hang up
+                shutdown(conn.fd, SHUT_WR);
+                conn.sentEof = true;
+            }
+        }
+    }
+    return true;
+}
+
+// Asks the event loop to exit
+void DepotServer::stop() {
+    running = false;
+    wake();
+}
+
+// Writes one byte to the self-pipe so poll() returns
+void DepotServer::wake() {
+    if (wakePipe[1] >= 0) {
+        char byte = 1;
+        ssize_t ignored = write(wakePipe[1], &byte, 1);
+        (void)ignored;
+    }
+}
+
+// --- Event Loop Helpers ---
+
+// Accepts every waiting client
+void DepotServer::acceptClients() {
+    while (true) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) return;
+        setNonBlocking(fd);
+        Connection& conn = connections[nextConnId++];
+        conn.fd = fd;
+        conn.nextSeq = 0;
+        conn.nextToSend = 0;
+        conn.outstanding = 0;
+        conn.peerClosed = false;
+        conn.rejected = false;
+        conn.sentEof = false;
+    }
+}
+
+// Reads available bytes and queues every complete request line
+void DepotServer::readClient(long long connId, Connection& conn) {
+    char buffer[4096];
+    while (!conn.peerClosed) {
+        ssize_t got = recv(conn.fd, buffer, sizeof(buffer), 0);
+        if (got <= 0) {
+            if (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                conn.peerClosed = true;
+            }
+            break;
+        }
+        if (conn.rejected) continue; // drained and dropped
+        conn.inBuffer.append(buffer, got);
+
+        size_t start = 0;
+        size_t newline;
+        while ((newline = conn.inBuffer.find('\n', start)) != string::npos) {
+            Request request;
+            request.seq = conn.nextSeq++;
+            request.line = conn.inBuffer.substr(start, newline - start);
+            if (!request.line.empty() && request.line.back() == '\r') request.line.pop_back();
+            conn.pending.push_back(request);
+            start = newline + 1;
+        }
+        conn.inBuffer.erase(0, start);
+
+        // A line that never ends would grow the buffer forever
+        if (conn.inBuffer.size() > MAX_LINE_BYTES) {
+            conn.finished[conn.nextSeq++] = frameResponse(false, "Request line too long.\n");
+            conn.inBuffer.clear();
+            conn.rejected = true;
+        }
+    }
+
+    pumpRequests(connId, conn);
+    writeClient(conn);
+}
+
+// Sends as much buffered output as the socket accepts
+void DepotServer::writeClient(Connection& conn) {
+    while (!conn.outBuffer.empty()) {
+        ssize_t sent = send(conn.fd, conn.outBuffer.data(), conn.outBuffer.size(), MSG_NOSIGNAL);
+        if (sent > 0) {
+            conn.outBuffer.erase(0, sent);
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            return;
+        }
+        // Peer is gone; discard whatever it can no longer receive
+        conn.outBuffer.clear();
+        conn.peerClosed = true;
+        return;
+    }
+}
+
+// Takes finished jobs from the workers and routes them to their clients
+void DepotServer::collectCompletions() {
+    deque<Completion> done;
+    {
+        lock_guard<mutex> guard(completionsLock);
+        done.swap(completions);
+    }
+    for (size_t i = 0; i < done.size(); ++i) {
+        map<long long, Connection>::iterator it = connections.find(done[i].connId);
+        if (it == connections.end()) continue; // client already gone
+        Connection& conn = it->second;
+        conn.finished[done[i].seq] = std::move(done[i].response);
+        --conn.outstanding;
+        queueResponses(conn);
+        pumpRequests(it->first, conn);
+        writeClient(conn);
+    }
+}
+
+// Starts pending requests in order; an edit waits for earlier reads to finish
+void DepotServer::pumpRequests(long long connId, Connection& conn) {
+    while (!conn.pending.empty()) {
+        Request& request = conn.pending.front();
+        if (isReadOnlyRequest(request.line)) {
+            {
+                lock_guard<mutex> guard(jobsLock);
+                jobs.push_back({ connId, request.seq, request.line });
+            }
+            jobsReady.notify_one();
+            ++conn.outstanding;
+        } else if (conn.outstanding == 0) {
+            unique_lock<shared_mutex> guard(depotLock);
+            conn.finished[request.seq] = executeRequest(request.line);
+        } else {
+            break;
+        }
+        conn.pending.pop_front();
+    }
+    queueResponses(conn);
+}
+
+// Moves in-order finished responses into the output buffer
+void DepotServer::queueResponses(Connection& conn) {
+    map<long long, string>::iterator it;
+    while ((it = conn.finished.find(conn.nextToSend)) != conn.finished.end()) {
+        conn.outBuffer += it->second;
+        conn.finished.erase(it);
+        ++conn.nextToSend;
+    }
+}
+
+// Closes a client socket and forgets its state
+void DepotServer::closeClient(long long connId) {
+    map<long long, Connection>::iterator it = connections.find(connId);
+    if (it == connections.end()) return;
+    close(it->second.fd);
+    connections.erase(it);
+}
+
+// --- Request Handling ---
+
+// Worker thread: runs read-only jobs under a shared lock
+void DepotServer::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            unique_lock<mutex> guard(jobsLock);
+            jobsReady.wait(guard, [this] { return !running || !jobs.empty(); });
+            if (!running) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        Completion done;
+        done.connId = job.connId;
+        done.seq = job.seq;
+        {
+            shared_lock<shared_mutex> guard(depotLock);
+            done.response = executeRequest(job.line);
+        }
+        {
+            lock_guard<mutex> guard(completionsLock);
+            completions.push_back(std::move(done));
+        }
+        wake();
+    }
+}
+
+// True for requests that never change the depot
+bool DepotServer::isReadOnlyRequest(const string& line) {
+    istringstream in(line);
+    string op;
+    in >> op;
+    return op == "COUNT" || op == "NAMES" || op == "GET" || op == "GREEDY" || op == "OPTIMAL"
+        || op == "PREFIX" || op == "FUZZY" || op == "TASK" || op == "NEAR"
+        || op == "FIND_NAME" || op == "FIND_ID";
+}
+
+// Parses and runs one request; the caller holds the right depot lock
+string DepotServer::executeRequest(const string& line) {
+    istringstream in(line);
+    ostringstream out;
+    string op;
+    in >> op;
+    int n = depot.getNumDrones();
+
+    if (op == "COUNT") {
+        out << n << "\n";
+        return frameResponse(true, out.str());
+    }
+    if (op == "NAMES") {
+        depot.printAllNames(out);
+        return frameResponse(true, out.str());
+    }
+    if (op == "GET" || op == "GREEDY" || op == "OPTIMAL") {
+        int idx;
+        if (!(in >> idx) || idx < 0 || idx >= n) {
+            return frameResponse(false, "Invalid index.\n");
+        }
+        const Depot& reader = depot;
+        if (op == "GET") {
+            reader.getDrone(idx).displayDrone(out);
+        } else if (op == "GREEDY") {
+            Depot::computeGreedyRoute(reader.getDrone(idx), out);
+        } else {
+            Depot::computeOptimalRoute(reader.getDrone(idx), out);
+        }
+        return frameResponse(true, out.str());
+    }
+    if (op == "PREFIX" || op == "FUZZY") {
+        const int pageSize = 20;
+        string name;
+        int maxEdits = 0;
+        int page = 1;
+        if (!(in >> name) || (op == "FUZZY" && !(in >> maxEdits))) {
+            return frameResponse(false, "Usage: PREFIX <prefix> [page] | FUZZY <name> <edits> [page]\n");
+        }
+        in >> page;
+        vector<int> results;
+        if (op == "PREFIX") {
+            depot.findDronesByPrefix(name, results);
+        } else {
+            depot.findDronesFuzzy(name, maxEdits, results);
+        }
+        depot.displayDronePage(results, page, pageSize, out);
+        return frameResponse(true, out.str());
+    }
+    if (op == "TASK" || op == "NEAR") {
+        vector<TaskPosting> results;
+        if (op == "TASK") {
+            string task;
+            if (!(in >> task)) return frameResponse(false, "Usage: TASK <task>\n");
+            depot.findDronesByTask(task, results);
+        } else {
+            int x, y;
+            double radius;
+            if (!(in >> x >> y >> radius)) return frameResponse(false, "Usage: NEAR <x> <y> <radius>\n");
+            depot.findTasksNear(x, y, radius, results);
+        }
+        depot.printTaskPostings(results, out);
+        return frameResponse(true, out.str());
+    }
+    if (op == "FIND_NAME" || op == "FIND_ID") {
+        // Index lookups: no re-sort, so slots other clients hold stay valid
+        const Depot& reader = depot;
+        int idx;
+        if (op == "FIND_NAME") {
+            string name;
+            if (!(in >> name)) return frameResponse(false, "Missing name.\n");
+            idx = reader.findDroneByName(name);
+        } else {
+            int id;
+            if (!(in >> id)) return frameResponse(false, "Missing ID.\n");
+            idx = reader.findDroneByID(id);
+        }
+        if (idx == -1) {
+            return frameResponse(false, "Drone not found.\n");
+        }
+        out << idx << "\n";
+        reader.getDrone(idx).displayDrone(out);
+        return frameResponse(true, out.str());
+    }
+    if (op == "INSERT") {
+        int droneIdx, taskIdx, x, y;
+        string task;
+        if (!(in >> droneIdx >> taskIdx >> task >> x >> y)) {
+            return frameResponse(false, "Usage: INSERT <idx> <slot> <task> <x> <y>\n");
+        }
+        if (droneIdx < 0 || droneIdx >= n || taskIdx < 0 || taskIdx >= 5) {
+            return frameResponse(false, "Invalid index.\n");
+        }
+        // Checked here so the setters never print on the loop thread
+        if (!Drone::positionFits(x) || !Drone::positionFits(y)) {
+            return frameResponse(false, "Position outside the stored coordinate range.\n");
+        }
+        int pos[2] = { x, y };
+        depot.insertDroneTask(droneIdx, taskIdx, task, pos);
+        return frameResponse(true, "Task inserted.\n");
+    }
+    if (op == "SWAP" || op == "COPY") {
+        int a, b;
+        if (!(in >> a >> b) || a < 0 || b < 0 || a >= n || b >= n) {
+            return frameResponse(false, "Invalid indices.\n");
+        }
+        if (op == "SWAP") {
+            if (a == b) return frameResponse(false, "Indices are the same; nothing to swap.\n");
+            // Indices were checked above, so these print nothing
+            depot.swapDroneData(a, b);
+            return frameResponse(true, "Swapped.\n");
+        }
+        depot.copyDrone(a, b);
+        return frameResponse(true, "Drone copied.\n");
+    }
+    return frameResponse(false, "Unknown request: " + op + "\n");
+}
@@ -0,0 +1,137 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * File: DepotServer.h
+ * Purpose:
+ *   Declares DepotServer: a daemon that keeps one loaded Depot in memory and
+ *   answers requests over a Unix domain socket. A single event-loop thread
+ *   owns all sockets; read-only requests are handed to a worker pool, edits
+ *   run on the loop thread under an exclusive lock.
+ *
+ * Protocol (one request per line, any number pipelined per connection):
+ *   COUNT                       number of drones
+ *   NAMES                       roster (printAllNames)
+ *   GET <idx>                   displayDrone
+ *   GREEDY <idx>                greedy route block
+ *   OPTIMAL <idx>               optimal route block
+ *   PREFIX <prefix> [page]      one page of drones whose name has the prefix
+ *   FUZZY <name> <edits> [page] one page of drones within <edits> of name
+ *   TASK <task>                 drones carrying a task with that name
+ *   NEAR <x> <y> <radius>       tasks within radius of (x, y)
+ *   FIND_NAME <name>            index + displayDrone (name index, lowest slot)
+ *   FIND_ID <id>                index + displayDrone (ID index, lowest slot)
+ *   INSERT <idx> <slot> <task> <x> <y>
+ *   SWAP <idx1> <idx2>
+ *   COPY <src> <dest>
+ * Each response is "OK <bytes>\n" or "ERR <bytes>\n" followed by exactly
+ * <bytes> of payload. Responses on a connection come back in request order.
+ * A line longer than MAX_LINE_BYTES gets one ERR; the server then ignores
+ * the rest of that client's input and shuts down its side of the socket.
+ */
+
+#ifndef DEPOTSERVER_H
+#define DEPOTSERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Depot.h"
+
+using namespace std;
+
+// DepotServer class definition
+class DepotServer {
+private:
+    static const size_t MAX_LINE_BYTES = 64 * 1024; // longest accepted request line
+
+    // One parsed request waiting to run
+    struct Request {
+        long long seq;
+        string line;
+    };
+
+    // A request handed to the worker pool
+    struct Job {
+        long long connId;
+        long long seq;
+        string line;
+    };
+
+    // A finished job waiting for the loop thread
+    struct Completion {
+        long long connId;
+        long long seq;
+        string response;
+    };
+
+    // Per-client state, owned by the loop thread
+    struct Connection {
+        int fd;
+        string inBuffer;                 // bytes read but not yet a full line
+        string outBuffer;                // responses not yet sent
+        deque<Request> pending;          // parsed, not yet dispatched
+        map<long long, string> finished; // responses waiting for their turn
+        long long nextSeq;               // seq for the next parsed request
+        long long nextToSend;            // seq of the next response to send
+        int outstanding;                 // requests running on workers
+        bool peerClosed;                 // no more input; flush, then close
+        bool rejected;                   // sent an over-long line; input is discarded
+        bool sentEof;                    // our side shut down after a rejection
+    };
+
+    Depot& depot;
+    string socketPath;
+    int numWorkers;
+    int listenFd;
+    int wakePipe[2];
+    atomic<bool> running;
+
+    // Readers share the depot; edits take it exclusively
+    shared_mutex depotLock;
+
+    map<long long, Connection> connections;
+    long long nextConnId;
+
+    // Worker pool input and output
+    deque<Job> jobs;
+    mutex jobsLock;
+    condition_variable jobsReady;
+    deque<Completion> completions;
+    mutex completionsLock;
+    vector<thread> workers;
+
+    // --- Event Loop Helpers ---
+    void acceptClients();
+    void readClient(long long connId, Connection& conn);
+    void writeClient(Connection& conn);
+    void collectCompletions();
+    // Dispatches or runs pending requests while keeping their order
+    void pumpRequests(long long connId, Connection& conn);
+    // Moves in-order finished responses into the output buffer
+    void queueResponses(Connection& conn);
+    void closeClient(long long connId);
+    void wake();
+
+    // --- Request Handling ---
+    void workerLoop();
+    static bool isReadOnlyRequest(const string& line);
+    // Parses and runs one request; returns the framed response
+    string executeRequest(const string& line);
+
+public:
+    // Serves depot on socketPath; numWorkers threads run read-only requests
+    DepotServer(Depot& depot, const string& socketPath, int numWorkers);
+    ~DepotServer();
+
+    // Binds the socket and runs the event loop until stop(); false on setup error
+    bool run();
+    // Asks the event loop to exit (safe to call from a signal handler)
+    void stop();
+};
+
+#endif //DEPOTSERVER_H
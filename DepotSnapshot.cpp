@@ -0,0 +1,126 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * Authors: Andy, Patrick, Kaicheng
+ * File: DepotSnapshot.cpp
+ * Purpose:
+ *   Implements DepotSnapshot: edits on a forked fleet, and the diff/route
+ *   comparison against the fleet it was forked from.
+ *
+ * Notes:
+ *   - Unchanged drones have identical routes before and after, so printDiff()
+ *     only solves routes for the changed drones; the fleet deltas it prints
+ *     are still exact.
+ */
+
+#include "DepotSnapshot.h"
+#include "Depot.h"
+#include <iomanip>
+
+using namespace std;
+
+// Constructor: both stores share the fleet until the first edit
+DepotSnapshot::DepotSnapshot(const DroneStore& fleet) : base(fleet), drones(fleet) {}
+
+bool DepotSnapshot::checkIndex(int idx) const {
+    if (idx < 0 || idx >= drones.size()) {
+        cout << "Error: Invalid drone index " << idx << "." << endl;
+        return false;
+    }
+    return true;
+}
+
+int DepotSnapshot::getNumDrones() const {
+    return drones.size();
+}
+
+// Read-only access (no index checks)
+const Drone& DepotSnapshot::getDrone(int index) const {
+    return drones[index];
+}
+
+// Swaps task data (tasks + task positions) between two drones
+bool DepotSnapshot::swapDroneData(int index1, int index2) {
+    if (!checkIndex(index1) || !checkIndex(index2)) return false;
+    if (index1 == index2) {
+        cout << "Swap skipped: indices are the same." << endl;
+        return false;
+    }
+    Drone& d1 = drones.mut(index1);
+    Drone& d2 = drones.mut(index2);
+    d1 - d2;
+    return true;
+}
+
+// Copies drone data from index1 to index2
+bool DepotSnapshot::copyDrone(int index1, int index2) {
+    if (!checkIndex(index1) || !checkIndex(index2)) return false;
+    drones.mut(index2) << drones[index1];
+    return true;
+}
+
+// Inserts a task into one drone and repairs its kept route
+bool DepotSnapshot::insertDroneTask(int droneidx, int taskidx, const string& task, const int task_pos[2]) {
+    if (!checkIndex(droneidx)) return false;
+    if (taskidx < 0 || taskidx >= 5) {
+        cout << "Error: Task index must be 0-4." << endl;
+        return false;
+    }
+    if (!Drone::positionFits(task_pos[0]) || !Drone::positionFits(task_pos[1])) {
+        cout << "Error: Task position is outside the stored coordinate range." << endl;
+        return false;
+    }
+    Drone& d = drones.mut(droneidx);
+    d.setTask(taskidx, task);
+    d.setTaskPosition(taskidx, 0, task_pos[0]);
+    d.setTaskPosition(taskidx, 1, task_pos[1]);
+    d.repairRoute(taskidx);
+    return true;
+}
+
+// Indices of drones that differ from the depot at snapshot time
+void DepotSnapshot::getChangedDrones(vector<int>& changed) const {
+    drones.diff(base, changed);
+}
+
+long long DepotSnapshot::getEditBytes() const {
+    return drones.unsharedBytes(base);
+}
+
+// Route totals before/after for each changed drone, then fleet deltas
+void DepotSnapshot::printDiff(ostream& out) const {
+    vector<int> changed;
+    getChangedDrones(changed);
+    if (changed.empty()) {
+        out << "No changes in this snapshot." << endl;
+        return;
+    }
+
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << fixed << setprecision(2);
+
+    double greedyDelta = 0.0;
+    double optimalDelta = 0.0;
+    for (size_t i = 0; i < changed.size(); ++i) {
+        const Drone& before = base[changed[i]];
+        const Drone& after = drones[changed[i]];
+        double greedyBefore = Depot::getGreedyRouteLength(before);
+        double greedyAfter = Depot::getGreedyRouteLength(after);
+        double optimalBefore = Depot::getOptimalRouteLength(before);
+        double optimalAfter = Depot::getOptimalRouteLength(after);
+        greedyDelta += greedyAfter - greedyBefore;
+        optimalDelta += optimalAfter - optimalBefore;
+
+        out << "[" << changed[i] << "] " << before.getName();
+        if (after.getName() != before.getName()) out << " -> " << after.getName();
+        out << ": greedy " << greedyBefore << " -> " << greedyAfter
+            << ", optimal " << optimalBefore << " -> " << optimalAfter << endl;
+    }
+    out << "Changed drones: " << changed.size() << endl;
+    out << "Fleet greedy total change: " << showpos << greedyDelta << noshowpos << endl;
+    out << "Fleet optimal total change: " << showpos << optimalDelta << noshowpos << endl;
+    out << "Snapshot storage not shared with depot: " << getEditBytes() << " bytes" << endl;
+
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -0,0 +1,67 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * File: DepotSnapshot.h
+ * Purpose:
+ *   Declares DepotSnapshot: a what-if copy of a Depot's fleet made with
+ *   Depot::snapshot(). Taking one is O(1) (the fleet storage is shared
+ *   copy-on-write), and each edit copies only the 64-drone chunk it touches,
+ *   so many variants cost memory in proportion to their edits. A snapshot can
+ *   list and print the drones it changed with their route totals before and
+ *   after, then be committed with Depot::commitSnapshot() or simply dropped.
+ *
+ * Notes:
+ *   - Snapshots keep no name/task indexes; the Depot updates its own indexes
+ *     for the changed drones on commit.
+ */
+
+#ifndef DEPOTSNAPSHOT_H
+#define DEPOTSNAPSHOT_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Drone.h"
+#include "DroneStore.h"
+
+using namespace std;
+
+// DepotSnapshot class definition
+class DepotSnapshot {
+private:
+    friend class Depot;
+
+    // Fleet as it was when the snapshot was taken
+    DroneStore base;
+    // Fleet with this snapshot's edits applied
+    DroneStore drones;
+
+    // Only Depot::snapshot() creates snapshots
+    explicit DepotSnapshot(const DroneStore& fleet);
+
+    // True (and nothing printed) when idx is a valid drone index
+    bool checkIndex(int idx) const;
+
+public:
+    // --- Read Access ---
+    int getNumDrones() const;
+    const Drone& getDrone(int index) const;
+
+    // --- What-If Edits (same rules as the Depot versions; false on bad input) ---
+    // Swaps task data between two drones
+    bool swapDroneData(int index1, int index2);
+    // Copies drone data from index1 to index2
+    bool copyDrone(int index1, int index2);
+    // Inserts a task and repairs the drone's kept route
+    bool insertDroneTask(int droneidx, int taskidx, const string& task, const int task_pos[2]);
+
+    // --- Comparison ---
+    // Indices of drones that differ from the depot at snapshot time
+    void getChangedDrones(vector<int>& changed) const;
+    // Bytes of drone storage this snapshot no longer shares with the depot
+    long long getEditBytes() const;
+    // Prints greedy/optimal route totals before and after for each changed
+    // drone, then the fleet-wide change in both totals
+    void printDiff(ostream& out) const;
+};
+
+#endif //DEPOTSNAPSHOT_H
@@ -10,12 +10,17 @@
  * Notes:
  *   - operator<< copies all attributes from another Drone.
  *   - operator- swaps ONLY tasks and task positions with another Drone.
+ *   - operator== compares everything but the kept route.
+ *   - Coordinates are stored as PositionCoord (16-bit with
+ *     DRONE_COMPACT_POSITIONS); route code always works on decoded ints.
  */
 
 #include "Drone.h"
+#include "RouteSolver.h"
 #include <iostream>
 #include <string>
 #include <cmath> // For sqrt and pow
+#include <limits>
 #include <utility> // For std::swap
 
 using namespace std;
@@ -30,7 +35,9 @@ Drone::Drone() {
         tasks[i] = "";
         task_positions[i][0] = 0;
         task_positions[i][1] = 0;
+        route[i] = i;
     }
+    routeValid = false;
 }
 
 // --- Getter Implementations ---
@@ -87,14 +94,22 @@ void Drone::setTask(int index, string task) {
 void Drone::setInitPosition(int index, int pos) {
     // Check for valid index
     if (index == 0 || index == 1) {
-        this->init_position[index] = pos;
+        if (!positionFits(pos)) {
+            cout << "Error: Position " << pos << " is outside the stored coordinate range." << endl;
+            return;
+        }
+        this->init_position[index] = static_cast<PositionCoord>(pos);
     }
 }
 
 void Drone::setTaskPosition(int taskIndex, int posIndex, int pos) {
     // Check for valid indices
     if (taskIndex >= 0 && taskIndex < 5 && (posIndex == 0 || posIndex == 1)) {
-        this->task_positions[taskIndex][posIndex] = pos;
+        if (!positionFits(pos)) {
+            cout << "Error: Position " << pos << " is outside the stored coordinate range." << endl;
+            return;
+        }
+        this->task_positions[taskIndex][posIndex] = static_cast<PositionCoord>(pos);
     }
 }
 
@@ -112,6 +127,7 @@ void Drone::sortByAscending() {
                 // Swap corresponding task positions
                 std::swap(task_positions[j][0], task_positions[j + 1][0]);
                 std::swap(task_positions[j][1], task_positions[j + 1][1]);
+                swapRouteSlots(j, j + 1);
             }
         }
     }
@@ -129,6 +145,7 @@ void Drone::sortByDescending() {
                 // Swap corresponding task positions
                 std::swap(task_positions[j][0], task_positions[j + 1][0]);
                 std::swap(task_positions[j][1], task_positions[j + 1][1]);
+                swapRouteSlots(j, j + 1);
             }
         }
     }
@@ -137,11 +154,11 @@ void Drone::sortByDescending() {
 // --- Display Implementation ---
 
 // Displays all attributes of the drone
-void Drone::displayDrone() const {
-    cout << "Drone: " << name << " (ID=" << ID << ", Position=(" << init_position[0] << ", " << init_position[1] << "))" << endl;
-    cout << "Tasks:" << endl;
+void Drone::displayDrone(ostream& out) const {
+    out << "Drone: " << name << " (ID=" << ID << ", Position=(" << init_position[0] << ", " << init_position[1] << "))" << endl;
+    out << "Tasks:" << endl;
     for (int i = 0; i < 5; ++i) {
-        cout << i + 1 << ". " << tasks[i] << " at (" << task_positions[i][0] << "," << task_positions[i][1] << ")" << endl;
+        out << i + 1 << ". " << tasks[i] << " at (" << task_positions[i][0] << "," << task_positions[i][1] << ")" << endl;
     }
 }
 
@@ -158,7 +175,9 @@ void Drone::operator<<(const Drone& d2) {
         this->tasks[i] = d2.tasks[i];
         this->task_positions[i][0] = d2.task_positions[i][0];
         this->task_positions[i][1] = d2.task_positions[i][1];
+        this->route[i] = d2.route[i];
     }
+    this->routeValid = d2.routeValid;
 }
 
 // Swaps tasks and task positions with d2
@@ -166,7 +185,25 @@ void Drone::operator-(Drone& d2) {
     for (int i = 0; i < 5; ++i) {
         std::swap(this->tasks[i], d2.tasks[i]);
         std::swap(this->task_positions[i], d2.task_positions[i]);
+        std::swap(this->route[i], d2.route[i]);
+    }
+    std::swap(this->routeValid, d2.routeValid);
+}
+
+// Compares all stored attributes except the kept route
+bool Drone::operator==(const Drone& d2) const {
+    if (name != d2.name || ID != d2.ID
+        || init_position[0] != d2.init_position[0] || init_position[1] != d2.init_position[1]) {
+        return false;
     }
+    for (int i = 0; i < 5; ++i) {
+        if (tasks[i] != d2.tasks[i]
+            || task_positions[i][0] != d2.task_positions[i][0]
+            || task_positions[i][1] != d2.task_positions[i][1]) {
+            return false;
+        }
+    }
+    return true;
 }
 
 // --- Helper Implementation ---
@@ -177,3 +214,88 @@ double Drone::getDistanceToOrigin() const {
     double y = static_cast<double>(init_position[1]);
     return sqrt(pow(x, 2) + pow(y, 2));
 }
+
+// True if pos fits the coordinate storage type
+bool Drone::positionFits(int pos) {
+#ifdef DRONE_COMPACT_POSITIONS
+    return pos >= numeric_limits<PositionCoord>::min() && pos <= numeric_limits<PositionCoord>::max();
+#else
+    (void)pos;
+    return true;
+#endif
+}
+
+// Bytes one drone spends on its 12 stored coordinates
+int Drone::positionBytes() {
+    return static_cast<int>(sizeof(init_position) + sizeof(task_positions));
+}
+
+// --- Route Maintenance Implementations ---
+
+// Window of route positions re-optimised around a changed task
+static const int ROUTE_REPAIR_WINDOW = 3;
+
+// Renames slots a and b inside the kept route
+void Drone::swapRouteSlots(int a, int b) {
+    for (int i = 0; i < 5; ++i) {
+        if (route[i] == a) {
+            route[i] = b;
+        } else if (route[i] == b) {
+            route[i] = a;
+        }
+    }
+}
+
+bool Drone::hasRoute() const {
+    return routeValid;
+}
+
+int Drone::getRouteStop(int i) const {
+    // Check for valid index
+    if (i >= 0 && i < 5) {
+        return route[i];
+    }
+    return -1; // Return -1 on bad index
+}
+
+// Expands stored positions into the solvers' int layout
+void Drone::decodePositions(int startPos[2], int taskPos[5][2]) const {
+    startPos[0] = init_position[0];
+    startPos[1] = init_position[1];
+    for (int i = 0; i < 5; ++i) {
+        taskPos[i][0] = task_positions[i][0];
+        taskPos[i][1] = task_positions[i][1];
+    }
+}
+
+// Rebuilds the kept route with a full nearest-neighbour pass
+void Drone::resetRoute() {
+    int startPos[2];
+    int taskPos[5][2];
+    decodePositions(startPos, taskPos);
+    solveGreedyRoute(startPos, taskPos, 5, route);
+    routeValid = true;
+}
+
+// Cheapest-insertion repair of the kept route around one task
+void Drone::repairRoute(int taskIndex) {
+    if (taskIndex < 0 || taskIndex >= 5) {
+        return;
+    }
+    if (!routeValid) {
+        resetRoute(); // Nothing to repair yet
+        return;
+    }
+    int startPos[2];
+    int taskPos[5][2];
+    decodePositions(startPos, taskPos);
+    ::repairRoute(startPos, taskPos, 5, route, taskIndex, ROUTE_REPAIR_WINDOW);
+}
+
+// Length of the closed tour following the kept route
+double Drone::getRouteLength() const {
+    int startPos[2];
+    int taskPos[5][2];
+    decodePositions(startPos, taskPos);
+    return computeTourLength(startPos, taskPos, route, 5);
+}
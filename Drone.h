@@ -10,11 +10,21 @@
 #ifndef DRONE_H
 #define DRONE_H
 
+#include <cstdint>
 #include <string>
 #include <iostream>
 
 using namespace std;
 
+// Storage type of every stored coordinate. Building with
+// -DDRONE_COMPACT_POSITIONS keeps them in 16 bits (24 bytes less per drone);
+// setters then reject positions outside [-32768, 32767].
+#ifdef DRONE_COMPACT_POSITIONS
+typedef int16_t PositionCoord;
+#else
+typedef int PositionCoord;
+#endif
+
 // Drone class definition
 class Drone {
 private:
@@ -22,8 +32,16 @@ private:
     string name;
     int ID;
     string tasks[5];
-    int init_position[2];
-    int task_positions[5][2];
+    PositionCoord init_position[2];
+    PositionCoord task_positions[5][2];
+    // Kept route (task slots in visiting order), repaired on task edits
+    int route[5];
+    bool routeValid;
+
+    // Keeps the kept route pointing at the same tasks after two slots swap
+    void swapRouteSlots(int a, int b);
+    // Expands stored positions into int buffers for the route solvers
+    void decodePositions(int startPos[2], int taskPos[5][2]) const;
 
 public:
     // Default constructor
@@ -37,6 +55,8 @@ public:
     int getTaskPosition(int taskIndex, int posIndex) const;
     
     // --- Setters ---
+    // (position setters print an error and keep the old value if pos does not
+    // fit the coordinate storage)
     void setName(string name);
     void setID(int ID);
     void setTask(int index, string task);
@@ -50,18 +70,37 @@ public:
     void sortByDescending();
 
     // --- Display Method ---
-    // Displays all attributes of the drone
-    void displayDrone() const;
+    // Displays all attributes of the drone (to cout unless out is given)
+    void displayDrone(ostream& out = cout) const;
 
     // --- Operator Overloads ---
     // Copies all attributes from d2 into this object
     void operator<<(const Drone& d2);
     // Swaps tasks and task positions with d2
     void operator-(Drone& d2);
+    // True when name, ID, position, tasks and task positions all match
+    // (the kept route is derived data and is not compared)
+    bool operator==(const Drone& d2) const;
 
     // --- Helper Method ---
     // Calculates distance from origin for sorting in Depot
     double getDistanceToOrigin() const;
+    // True if pos fits the coordinate storage type
+    static bool positionFits(int pos);
+    // Bytes one drone spends on its 12 stored coordinates
+    static int positionBytes();
+
+    // --- Route Maintenance ---
+    // True once a route has been built for this drone
+    bool hasRoute() const;
+    // Task slot visited at step i of the kept route
+    int getRouteStop(int i) const;
+    // Rebuilds the kept route from scratch with the greedy solver
+    void resetRoute();
+    // Locally repairs the kept route after task slot taskIndex changed
+    void repairRoute(int taskIndex);
+    // Closed-tour length of the kept route
+    double getRouteLength() const;
 };
 
 #endif //DRONE_H
@@ -0,0 +1,131 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * Authors: Andy, Patrick, Kaicheng
+ * File: DroneStore.cpp
+ * Purpose:
+ *   Implements DroneStore: path copying on write, append, swap, and diffing
+ *   two stores by skipping the parts they still share.
+ */
+
+#include "DroneStore.h"
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+// Constructor: an empty, unshared root
+DroneStore::DroneStore() : root(make_shared<Root>()), count(0) {}
+
+int DroneStore::size() const {
+    return count;
+}
+
+const Drone& DroneStore::operator[](int i) const {
+    return root->groups[i >> (CHUNK_BITS + GROUP_BITS)]->chunks[(i >> CHUNK_BITS) & (GROUP_SIZE - 1)]
+        ->drones[i & (CHUNK_SIZE - 1)];
+}
+
+// Copies each shared level on the path to slot i
+DroneStore::Chunk& DroneStore::ownChunk(int i) {
+    if (root.use_count() > 1) {
+        root = make_shared<Root>(*root);
+    }
+    shared_ptr<Group>& group = root->groups[i >> (CHUNK_BITS + GROUP_BITS)];
+    if (group.use_count() > 1) {
+        group = make_shared<Group>(*group);
+    }
+    shared_ptr<Chunk>& chunk = group->chunks[(i >> CHUNK_BITS) & (GROUP_SIZE - 1)];
+    if (chunk.use_count() > 1) {
+        chunk = make_shared<Chunk>(*chunk);
+    }
+    return *chunk;
+}
+
+Drone& DroneStore::mut(int i) {
+    return ownChunk(i).drones[i & (CHUNK_SIZE - 1)];
+}
+
+// Appends a drone, opening a new chunk or group when the last one is full
+void DroneStore::push_back(const Drone& d) {
+    if (root.use_count() > 1) {
+        root = make_shared<Root>(*root);
+    }
+    if (count % (CHUNK_SIZE * GROUP_SIZE) == 0) {
+        root->groups.push_back(make_shared<Group>());
+    }
+    shared_ptr<Group>& group = root->groups.back();
+    if (group.use_count() > 1) {
+        group = make_shared<Group>(*group);
+    }
+    if (count % CHUNK_SIZE == 0) {
+        group->chunks.push_back(make_shared<Chunk>());
+        group->chunks.back()->drones.reserve(CHUNK_SIZE);
+    }
+    shared_ptr<Chunk>& chunk = group->chunks.back();
+    if (chunk.use_count() > 1) {
+        chunk = make_shared<Chunk>(*chunk);
+    }
+    chunk->drones.push_back(d);
+    ++count;
+}
+
+// Exchanges two drones (both paths are un-shared first)
+void DroneStore::swap(int i, int j) {
+    if (i == j) return;
+    // Un-sharing j's path never moves i's chunk, so a stays valid
+    Drone& a = mut(i);
+    Drone& b = mut(j);
+    std::swap(a, b);
+}
+
+bool DroneStore::sameRoot(const DroneStore& other) const {
+    return root == other.root;
+}
+
+// Slots whose drone differs from other
+void DroneStore::diff(const DroneStore& other, vector<int>& changed) const {
+    changed.clear();
+    if (root == other.root) return;
+
+    int common = min(count, other.count);
+    int perGroup = CHUNK_SIZE * GROUP_SIZE;
+    for (int g = 0; g * perGroup < common; ++g) {
+        if (root->groups[g] == other.root->groups[g]) continue; // whole group shared
+        const Group& mine = *root->groups[g];
+        const Group& theirs = *other.root->groups[g];
+        for (size_t c = 0; c < mine.chunks.size() && c < theirs.chunks.size(); ++c) {
+            if (mine.chunks[c] == theirs.chunks[c]) continue;   // whole chunk shared
+            int first = g * perGroup + static_cast<int>(c) * CHUNK_SIZE;
+            int last = min(common, first + CHUNK_SIZE);
+            for (int i = first; i < last; ++i) {
+                if (!((*this)[i] == other[i])) {
+                    changed.push_back(i);
+                }
+            }
+        }
+    }
+    // Slots only one side has
+    for (int i = common; i < max(count, other.count); ++i) {
+        changed.push_back(i);
+    }
+}
+
+// Bytes held by chunks that other does not share
+long long DroneStore::unsharedBytes(const DroneStore& other) const {
+    if (root == other.root) return 0;
+    long long bytes = 0;
+    for (size_t g = 0; g < root->groups.size(); ++g) {
+        bool sharedGroup = g < other.root->groups.size() && root->groups[g] == other.root->groups[g];
+        if (sharedGroup) continue;
+        const Group& mine = *root->groups[g];
+        bytes += sizeof(Group) + mine.chunks.capacity() * sizeof(shared_ptr<Chunk>);
+        for (size_t c = 0; c < mine.chunks.size(); ++c) {
+            bool sharedChunk = g < other.root->groups.size() && c < other.root->groups[g]->chunks.size()
+                && mine.chunks[c] == other.root->groups[g]->chunks[c];
+            if (!sharedChunk) {
+                bytes += sizeof(Chunk) + mine.chunks[c]->drones.capacity() * sizeof(Drone);
+            }
+        }
+    }
+    return bytes + sizeof(Root) + root->groups.capacity() * sizeof(shared_ptr<Group>);
+}
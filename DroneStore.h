@@ -0,0 +1,75 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * File: DroneStore.h
+ * Purpose:
+ *   Declares DroneStore: the Depot's fleet storage, a two-level persistent
+ *   array of Drones (root -> groups of 64 chunks -> chunks of 64 drones)
+ *   with copy-on-write sharing. Copying a DroneStore only copies one pointer,
+ *   so forking a fleet is O(1); the first write to a drone afterwards copies
+ *   just the root, group and chunk on its path, never the whole fleet.
+ *
+ * Notes:
+ *   - operator[] is read-only. Writes go through mut(), which un-shares the
+ *     path to that drone first.
+ *   - A store is not safe to write from several threads at once; reads of a
+ *     store nobody is writing are safe.
+ */
+
+#ifndef DRONESTORE_H
+#define DRONESTORE_H
+
+#include <memory>
+#include <vector>
+#include "Drone.h"
+
+using namespace std;
+
+// DroneStore class definition
+class DroneStore {
+public:
+    static const int CHUNK_BITS = 6; // 64 drones per chunk
+    static const int GROUP_BITS = 6; // 64 chunks per group
+    static const int CHUNK_SIZE = 1 << CHUNK_BITS;
+    static const int GROUP_SIZE = 1 << GROUP_BITS;
+
+private:
+    struct Chunk {
+        vector<Drone> drones;
+    };
+    struct Group {
+        vector<shared_ptr<Chunk> > chunks;
+    };
+    struct Root {
+        vector<shared_ptr<Group> > groups;
+    };
+
+    shared_ptr<Root> root;
+    int count;
+
+    // Un-shares the root, group and chunk holding slot i; returns the chunk
+    Chunk& ownChunk(int i);
+
+public:
+    DroneStore();
+
+    // Number of drones stored
+    int size() const;
+    // Read-only access (no index checks)
+    const Drone& operator[](int i) const;
+    // Writable access; copies shared storage on the path to slot i first
+    Drone& mut(int i);
+    // Appends a drone at slot size()
+    void push_back(const Drone& d);
+    // Exchanges the drones at slots i and j
+    void swap(int i, int j);
+
+    // True when both stores still point at the same root (no writes since
+    // one was copied from the other)
+    bool sameRoot(const DroneStore& other) const;
+    // Slots whose drone differs from other (skips shared groups and chunks)
+    void diff(const DroneStore& other, vector<int>& changed) const;
+    // Bytes of chunk storage not shared with other (for what-if reports)
+    long long unsharedBytes(const DroneStore& other) const;
+};
+
+#endif //DRONESTORE_H
@@ -0,0 +1,171 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * Authors: Andy, Patrick, Kaicheng
+ * File: DroneStream.cpp
+ * Purpose:
+ *   Implements the streaming route pipeline: a parser stage, a pool of route
+ *   workers and an in-order writer stage, connected by bounded queues.
+ *
+ * Notes:
+ *   - Workers may finish out of order; the writer holds finished records
+ *     until their turn so the output matches the input order.
+ *   - An in-flight window caps records that are parsed but not yet written,
+ *     which also bounds the writer's reorder buffer.
+ *   - A malformed record stops the parser; records before it are still
+ *     routed and written, and its number is reported to the caller.
+ */
+
+#include "DroneStream.h"
+#include "Depot.h"
+#include <atomic>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Reads one drone record; returns false at end of input or on bad data
+bool readDroneRecord(istream& in, Drone& d) {
+    string name;
+    int id, x, y;
+
+    if (!(in >> name)) return false;         // stop if no more records
+    if (!(in >> id >> x >> y)) return false; // read drone ID and (x,y)
+    // A coordinate the storage cannot hold makes the whole record bad
+    if (!Drone::positionFits(x) || !Drone::positionFits(y)) return false;
+
+    d.setName(name);
+    d.setID(id);
+    d.setInitPosition(0, x);
+    d.setInitPosition(1, y);
+
+    for (int j = 0; j < 5; j++) {
+        string task;
+        int tx, ty;
+        if (!(in >> task >> tx >> ty)) return false; // read one task and its (x,y)
+        if (!Drone::positionFits(tx) || !Drone::positionFits(ty)) return false;
+        d.setTask(j, task);
+        d.setTaskPosition(j, 0, tx);
+        d.setTaskPosition(j, 1, ty);
+    }
+    return true;
+}
+
+namespace {
+
+// A parsed drone waiting for a worker
+struct StreamJob {
+    long long seq;
+    Drone drone;
+};
+
+// A finished Depot.txt record waiting for the writer
+struct StreamResult {
+    long long seq;
+    string text;
+};
+
+// Counting gate limiting how many records are between parse and write
+class InFlightWindow {
+private:
+    int available;
+    mutex lock;
+    condition_variable freed;
+
+public:
+    explicit InFlightWindow(int size) : available(size) {}
+
+    void acquire() {
+        unique_lock<mutex> guard(lock);
+        freed.wait(guard, [this] { return available > 0; });
+        --available;
+    }
+
+    void release() {
+        lock_guard<mutex> guard(lock);
+        ++available;
+        freed.notify_one();
+    }
+};
+
+} // namespace
+
+// Streams records from in to out through parse -> solve -> write stages
+long long streamDepotRoutes(istream& in, ostream& out, int numWorkers, int queueCapacity,
+                            long long* badRecord) {
+    if (numWorkers < 1) numWorkers = 1;
+    if (queueCapacity < 1) queueCapacity = 1;
+
+    BoundedQueue<StreamJob> jobs(queueCapacity);
+    BoundedQueue<StreamResult> results(queueCapacity);
+    InFlightWindow window(queueCapacity);
+    atomic<int> liveWorkers(numWorkers);
+    long long malformed = 0;
+
+    // Parse stage: blocks on the window when the writer falls behind
+    thread parser([&] {
+        long long seq = 0;
+        while (true) {
+            // Only trailing whitespace left means a clean end of input
+            in >> ws;
+            if (in.eof()) break;
+            StreamJob job;
+            job.seq = seq;
+            if (!readDroneRecord(in, job.drone)) {
+                malformed = seq + 1;
+                break;
+            }
+            window.acquire();
+            if (!jobs.push(std::move(job))) break;
+            ++seq;
+        }
+        jobs.close();
+    });
+
+    // Solve stage: each worker formats a full record with both routes
+    vector<thread> workers;
+    for (int w = 0; w < numWorkers; ++w) {
+        workers.emplace_back([&] {
+            StreamJob job;
+            while (jobs.pop(job)) {
+                ostringstream record;
+                record << fixed;
+                record.precision(2);
+                Depot::writeDroneRecord(job.drone, record);
+
+                StreamResult result;
+                result.seq = job.seq;
+                result.text = record.str();
+                results.push(std::move(result));
+            }
+            // Last worker out closes the result queue
+            if (--liveWorkers == 0) {
+                results.close();
+            }
+        });
+    }
+
+    // Write stage: emit records in input order
+    map<long long, string> pending;
+    long long nextSeq = 0;
+    StreamResult result;
+    while (results.pop(result)) {
+        pending[result.seq] = std::move(result.text);
+        while (!pending.empty() && pending.begin()->first == nextSeq) {
+            out << pending.begin()->second;
+            pending.erase(pending.begin());
+            ++nextSeq;
+            window.release();
+        }
+    }
+    out.flush();
+
+    parser.join();
+    for (size_t w = 0; w < workers.size(); ++w) {
+        workers[w].join();
+    }
+    if (badRecord) *badRecord = malformed;
+    return nextSeq;
+}
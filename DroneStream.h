@@ -0,0 +1,85 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * File: DroneStream.h
+ * Purpose:
+ *   Declares the streaming route pipeline used for fleets that do not fit in
+ *   memory: drone records are parsed from DroneInput.txt-format input, routed
+ *   by a bounded pool of workers, and written in Depot.txt format as they
+ *   finish. Every stage is connected by a bounded queue, so a slow stage
+ *   blocks the one before it instead of letting records pile up.
+ */
+
+#ifndef DRONESTREAM_H
+#define DRONESTREAM_H
+
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include "Drone.h"
+
+using namespace std;
+
+// Reads one drone record (name id initX initY, then 5 "task x y" lines).
+// Returns false at end of input or on a malformed record, including one
+// with a coordinate that does not fit the coordinate storage.
+bool readDroneRecord(istream& in, Drone& d);
+
+// Fixed-capacity blocking FIFO connecting two pipeline stages
+template <typename T>
+class BoundedQueue {
+private:
+    deque<T> items;
+    size_t capacity;
+    bool closed;
+    mutex lock;
+    condition_variable notFull;
+    condition_variable notEmpty;
+
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity > 0 ? capacity : 1), closed(false) {}
+
+    // Blocks while the queue is full; returns false if the queue was closed
+    bool push(T item) {
+        unique_lock<mutex> guard(lock);
+        notFull.wait(guard, [this] { return closed || items.size() < capacity; });
+        if (closed) {
+            return false;
+        }
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Blocks while the queue is empty; returns false once closed and drained
+    bool pop(T& item) {
+        unique_lock<mutex> guard(lock);
+        notEmpty.wait(guard, [this] { return closed || !items.empty(); });
+        if (items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    // Wakes all waiters; pending items can still be popped
+    void close() {
+        lock_guard<mutex> guard(lock);
+        closed = true;
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+};
+
+// Streams every record from in to out (greedy + optimal route per drone),
+// keeping input order. At most queueCapacity records are in flight at once.
+// Returns the number of drones written. If badRecord is given it is set to
+// the 1-based number of the malformed record that stopped parsing, or 0 if
+// the whole input was read. Write errors are left in out's stream state.
+long long streamDepotRoutes(istream& in, ostream& out, int numWorkers, int queueCapacity,
+                            long long* badRecord = nullptr);
+
+#endif //DRONESTREAM_H
@@ -0,0 +1,385 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * Authors: Andy, Patrick, Kaicheng
+ * File: LargeTourSolver.cpp
+ * Purpose:
+ *   Implements the large-tour heuristic: a k-d tree over the stops,
+ *   tree-accelerated nearest-neighbour construction, K-nearest neighbour
+ *   lists, and Or-opt on a doubly linked tour.
+ *
+ * Notes:
+ *   - Node 0 is the start point; task i is node i + 1 (as in RouteSolver.cpp).
+ *     The start is never moved by Or-opt.
+ *   - The tree splits at the median stop, not at a fixed cell size, so it
+ *     stays O(log n) deep however the stops cluster; leaves cap the stops
+ *     one query scans at LARGE_TOUR_LEAF_SIZE.
+ *   - A visited stop is swapped to the end of its leaf's live range and the
+ *     live counts on its path drop by one; searches skip subtrees with no
+ *     live stops and subtrees whose box is farther than the best so far.
+ */
+
+#include "LargeTourSolver.h"
+#include "RouteSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Slack when deciding whether a move shortens the tour
+const double GAIN_EPSILON = 1e-9;
+
+// k-d tree over the task points. Leaves hold at most LARGE_TOUR_LEAF_SIZE
+// stops, and every node keeps the bounding box of its stops and how many
+// of them are still live
+class StopTree {
+private:
+    struct Node {
+        int minX, minY, maxX, maxY;  // bounding box of the node's stops
+        int first, last;             // stops in items[first, last)
+        int left, right;             // children, -1 for a leaf
+        int parent;
+        int live;                    // stops not yet removed
+    };
+
+    // Stops are renumbered in tree order after the build, so a stop's
+    // number is its slot and neighbouring stops sit next to each other in
+    // memory; original maps them back to the caller's task indices
+    const int (*pts)[2];
+    vector<int> coords;      // x0 y0 x1 y1 ... in tree order
+    vector<int> original;    // stop -> caller's task index
+    vector<Node> nodes;
+    vector<int> items;       // stops; a leaf's live ones come first
+    vector<int> slotOf;      // stop -> slot in items
+    vector<int> leafOf;      // stop -> leaf node
+
+    static double dist2(int ax, int ay, int bx, int by) {
+        double dx = static_cast<double>(ax) - bx;
+        double dy = static_cast<double>(ay) - by;
+        return dx * dx + dy * dy;
+    }
+
+    // Squared distance from (x, y) to the node's box (0 inside it)
+    double boxDist2(const Node& node, int x, int y) const {
+        double dx = 0.0, dy = 0.0;
+        if (x < node.minX) dx = static_cast<double>(node.minX) - x;
+        else if (x > node.maxX) dx = static_cast<double>(x) - node.maxX;
+        if (y < node.minY) dy = static_cast<double>(node.minY) - y;
+        else if (y > node.maxY) dy = static_cast<double>(y) - node.maxY;
+        return dx * dx + dy * dy;
+    }
+
+    // Builds the subtree over items[first, last); returns its node
+    int build(int first, int last, int parent) {
+        int id = static_cast<int>(nodes.size());
+        nodes.push_back(Node());
+        Node node;
+        node.first = first;
+        node.last = last;
+        node.left = node.right = -1;
+        node.parent = parent;
+        node.live = last - first;
+        node.minX = node.maxX = pts[items[first]][0];
+        node.minY = node.maxY = pts[items[first]][1];
+        for (int s = first + 1; s < last; ++s) {
+            const int* p = pts[items[s]];
+            node.minX = min(node.minX, p[0]);
+            node.maxX = max(node.maxX, p[0]);
+            node.minY = min(node.minY, p[1]);
+            node.maxY = max(node.maxY, p[1]);
+        }
+
+        if (last - first <= LARGE_TOUR_LEAF_SIZE) {
+            for (int s = first; s < last; ++s) {
+                leafOf[s] = id;
+            }
+        } else {
+            // Split at the median of the wider side. Splitting by position
+            // (not value) keeps the tree balanced even for repeated points
+            int axis = (static_cast<long long>(node.maxX) - node.minX
+                        >= static_cast<long long>(node.maxY) - node.minY) ? 0 : 1;
+            int mid = first + (last - first) / 2;
+            const int (*p)[2] = pts;
+            nth_element(items.begin() + first, items.begin() + mid, items.begin() + last,
+                        [p, axis](int a, int b) { return p[a][axis] < p[b][axis]; });
+            node.left = build(first, mid, id);
+            node.right = build(mid, last, id);
+        }
+        nodes[id] = node;
+        return id;
+    }
+
+    void nearestIn(int id, int x, int y, int& best, double& bestD2, long long& examined) const {
+        const Node& node = nodes[id];
+        if (node.live == 0 || boxDist2(node, x, y) >= bestD2) return;
+        if (node.left == -1) {
+            for (int s = node.first; s < node.first + node.live; ++s) {
+                int t = items[s];
+                ++examined;
+                double d2 = dist2(x, y, pts[t][0], pts[t][1]);
+                if (d2 < bestD2 || (d2 == bestD2 && t < best)) {
+                    bestD2 = d2;
+                    best = t;
+                }
+            }
+            return;
+        }
+        // Nearer child first so the farther one is usually pruned
+        int a = node.left, b = node.right;
+        if (boxDist2(nodes[b], x, y) < boxDist2(nodes[a], x, y)) std::swap(a, b);
+        nearestIn(a, x, y, best, bestD2, examined);
+        nearestIn(b, x, y, best, bestD2, examined);
+    }
+
+    void nearestKIn(int id, int task, int k, vector<int>& out, vector<double>& outD2,
+                    long long& examined) const {
+        const Node& node = nodes[id];
+        int x = pts[task][0], y = pts[task][1];
+        if (static_cast<int>(out.size()) == k && boxDist2(node, x, y) >= outD2.back()) return;
+        if (node.left == -1) {
+            for (int s = node.first; s < node.last; ++s) {
+                int t = items[s];
+                if (t == task) continue;
+                ++examined;
+                double d2 = dist2(x, y, pts[t][0], pts[t][1]);
+                if (static_cast<int>(out.size()) == k && d2 >= outD2.back()) continue;
+                // Insertion into the short sorted list
+                size_t at = out.size();
+                while (at > 0 && (outD2[at - 1] > d2 || (outD2[at - 1] == d2 && out[at - 1] > t))) --at;
+                out.insert(out.begin() + at, t);
+                outD2.insert(outD2.begin() + at, d2);
+                if (static_cast<int>(out.size()) > k) {
+                    out.pop_back();
+                    outD2.pop_back();
+                }
+            }
+            return;
+        }
+        int a = node.left, b = node.right;
+        if (boxDist2(nodes[b], x, y) < boxDist2(nodes[a], x, y)) std::swap(a, b);
+        nearestKIn(a, task, k, out, outD2, examined);
+        nearestKIn(b, task, k, out, outD2, examined);
+    }
+
+public:
+    StopTree(const int taskPos[][2], int n)
+        : pts(taskPos), coords(2 * n), items(n), slotOf(n), leafOf(n) {
+        for (int i = 0; i < n; ++i) items[i] = i;
+        nodes.reserve(4 * (n / LARGE_TOUR_LEAF_SIZE + 1));
+        build(0, n, -1);
+
+        // Renumber: stop s is whatever task the build left in slot s
+        original.swap(items);
+        items.resize(n);
+        for (int s = 0; s < n; ++s) {
+            coords[2 * s] = taskPos[original[s]][0];
+            coords[2 * s + 1] = taskPos[original[s]][1];
+            items[s] = s;
+            slotOf[s] = s;
+        }
+        pts = reinterpret_cast<const int (*)[2]>(coords.data());
+    }
+
+    // Stop positions in tree order (stop i at points()[i])
+    const int (*points() const)[2] { return pts; }
+    // Caller's task index of a stop
+    int originalIndex(int stop) const { return original[stop]; }
+
+    // Takes a visited stop out of its leaf and the live counts above it
+    void remove(int task) {
+        int id = leafOf[task];
+        Node& leaf = nodes[id];
+        int last = leaf.first + leaf.live - 1;
+        int s = slotOf[task];
+        int other = items[last];
+        items[s] = other;
+        slotOf[other] = s;
+        items[last] = task;
+        slotOf[task] = last;
+        for (; id != -1; id = nodes[id].parent) --nodes[id].live;
+    }
+
+    // Closest live stop to (x, y); -1 if none left
+    int nearest(int x, int y, long long& examined) const {
+        int best = -1;
+        double bestD2 = numeric_limits<double>::infinity();
+        nearestIn(0, x, y, best, bestD2, examined);
+        return best;
+    }
+
+    // The k closest other stops to task (all stops live), nearest first
+    void nearestK(int task, int k, vector<int>& out, long long& examined) const {
+        out.clear();
+        if (k <= 0) return;
+        vector<double> outD2;
+        nearestKIn(0, task, k, out, outD2, examined);
+    }
+};
+
+// Closed tour as a doubly linked cycle over nodes 0..n (0 = start)
+struct LinkedTour {
+    const int* startPos;
+    const int (*pts)[2];
+    vector<int> next, prev;
+
+    const int* point(int node) const { return node == 0 ? startPos : pts[node - 1]; }
+
+    double d(int a, int b) const {
+        const int* pa = point(a);
+        const int* pb = point(b);
+        double dx = static_cast<double>(pa[0] - pb[0]);
+        double dy = static_cast<double>(pa[1] - pb[1]);
+        return sqrt(dx * dx + dy * dy);
+    }
+};
+
+// Tries Or-opt moves for segments starting at node a; applies the first
+// improving one and returns true. Touched endpoints are pushed on dirty
+bool improveFrom(LinkedTour& tour, int a, const vector<vector<int> >& neighbours,
+                 vector<int>& dirty, long long& examined) {
+    int e = a;
+    for (int len = 1; len <= LARGE_TOUR_MAX_SEGMENT; ++len) {
+        if (len > 1) {
+            e = tour.next[e];
+            if (e == 0 || e == a) return false;
+        }
+        int p = tour.prev[a];
+        int q = tour.next[e];
+        if (q == a || p == e) return false; // segment is the whole tour
+        double removeGain = tour.d(p, a) + tour.d(e, q) - tour.d(p, q);
+        if (removeGain <= GAIN_EPSILON) continue;
+
+        // Candidate gaps (u, v) next to a neighbour of either segment end,
+        // with the segment already taken out
+        for (int end = 0; end < 2; ++end) {
+            const vector<int>& near = neighbours[(end == 0 ? a : e) - 1];
+            for (size_t k = 0; k < near.size(); ++k) {
+                int c = near[k] + 1;
+                bool inSegment = false;
+                for (int s = a; ; s = tour.next[s]) {
+                    if (s == c) inSegment = true;
+                    if (s == e) break;
+                }
+                if (inSegment) continue;
+
+                int afterC = (c == p) ? q : tour.next[c];
+                int beforeC = (c == q) ? p : tour.prev[c];
+                int gaps[2][2] = { { c, afterC }, { beforeC, c } };
+                for (int g = 0; g < 2; ++g) {
+                    int u = gaps[g][0], v = gaps[g][1];
+                    if (u == p && v == q) continue; // where it came from
+                    ++examined;
+                    double base = tour.d(u, v);
+                    double forward = tour.d(u, a) + tour.d(e, v) - base;
+                    double reversed = tour.d(u, e) + tour.d(a, v) - base;
+                    bool reverse = reversed < forward;
+                    double add = reverse ? reversed : forward;
+                    if (removeGain - add <= GAIN_EPSILON) continue;
+
+                    // Unlink a..e, then splice it between u and v
+                    tour.next[p] = q;
+                    tour.prev[q] = p;
+                    vector<int> seg;
+                    for (int s = a; ; s = tour.next[s]) {
+                        seg.push_back(s);
+                        if (s == e) break;
+                    }
+                    if (reverse) std::reverse(seg.begin(), seg.end());
+                    int left = u;
+                    for (size_t i = 0; i < seg.size(); ++i) {
+                        tour.next[left] = seg[i];
+                        tour.prev[seg[i]] = left;
+                        left = seg[i];
+                    }
+                    tour.next[left] = v;
+                    tour.prev[v] = left;
+
+                    int touched[6] = { p, q, u, v, a, e };
+                    for (int t = 0; t < 6; ++t) {
+                        if (touched[t] != 0) dirty.push_back(touched[t]);
+                    }
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+// k-d tree nearest-neighbour tour improved by neighbour-list Or-opt
+double solveLargeTourRoute(const int start[2], const int taskPos[][2], int n, int order[], long long* evaluations) {
+    long long examined = 0;
+    if (evaluations) *evaluations = 0;
+    if (n <= 0) return 0.0;
+
+    // Everything below works on the tree's stop numbers (tree order)
+    StopTree tree(taskPos, n);
+    const int (*stops)[2] = tree.points();
+
+    // Neighbour lists first, while every stop is still in the tree
+    int k = min(LARGE_TOUR_NEIGHBOURS, n - 1);
+    vector<vector<int> > neighbours(n);
+    for (int i = 0; i < n; ++i) {
+        tree.nearestK(i, k, neighbours[i], examined);
+    }
+
+    // Nearest-neighbour construction
+    int cx = start[0], cy = start[1];
+    for (int i = 0; i < n; ++i) {
+        int t = tree.nearest(cx, cy, examined);
+        order[i] = t;
+        tree.remove(t);
+        cx = stops[t][0];
+        cy = stops[t][1];
+    }
+
+    // Or-opt on a linked copy of the tour, driven by a work stack of stops
+    // whose surroundings changed
+    LinkedTour tour;
+    tour.startPos = start;
+    tour.pts = stops;
+    tour.next.assign(n + 1, 0);
+    tour.prev.assign(n + 1, 0);
+    int last = 0;
+    for (int i = 0; i < n; ++i) {
+        tour.next[last] = order[i] + 1;
+        tour.prev[order[i] + 1] = last;
+        last = order[i] + 1;
+    }
+    tour.next[last] = 0;
+    tour.prev[0] = last;
+
+    vector<int> dirty;
+    vector<char> queued(n + 1, 1);
+    queued[0] = 0;
+    for (int i = n - 1; i >= 0; --i) dirty.push_back(order[i] + 1);
+    while (!dirty.empty()) {
+        int a = dirty.back();
+        dirty.pop_back();
+        if (a == 0) continue;
+        queued[a] = 0;
+        size_t before = dirty.size();
+        if (improveFrom(tour, a, neighbours, dirty, examined)) {
+            // Keep only newly dirtied stops that are not already waiting
+            size_t keep = before;
+            for (size_t i = before; i < dirty.size(); ++i) {
+                if (!queued[dirty[i]]) {
+                    queued[dirty[i]] = 1;
+                    dirty[keep++] = dirty[i];
+                }
+            }
+            dirty.resize(keep);
+        }
+    }
+
+    for (int i = 0, node = tour.next[0]; i < n; ++i, node = tour.next[node]) {
+        order[i] = tree.originalIndex(node - 1);
+    }
+    if (evaluations) *evaluations = examined;
+    return computeTourLength(start, taskPos, order, n);
+}
@@ -0,0 +1,33 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * File: LargeTourSolver.h
+ * Purpose:
+ *   Declares the large-tour heuristic for survey-style missions with
+ *   thousands of stops, where the O(n^2) greedy solver and the exact search
+ *   are too slow. A k-d tree over the stops answers nearest-neighbour
+ *   queries by looking only at nearby leaves, which builds the starting tour;
+ *   Or-opt then moves segments of 1-3 stops next to one of each endpoint's
+ *   K nearest neighbours while that shortens the tour.
+ *
+ * Notes:
+ *   - The tree adapts to the data, so runtime stays near O(n log n) for
+ *     clustered, repeated or outlying stops as well as evenly spread ones;
+ *     the tour is not optimal, only locally improved.
+ */
+
+#ifndef LARGETOURSOLVER_H
+#define LARGETOURSOLVER_H
+
+// Neighbours kept per stop for Or-opt candidate moves
+const int LARGE_TOUR_NEIGHBOURS = 8;
+// Longest segment Or-opt moves
+const int LARGE_TOUR_MAX_SEGMENT = 3;
+// Most stops in one k-d tree leaf (work per leaf visited by a search)
+const int LARGE_TOUR_LEAF_SIZE = 8;
+
+// k-d tree nearest-neighbour tour followed by neighbour-list Or-opt. Same
+// signature and conventions as the other solvers in RouteSolver.h.
+double solveLargeTourRoute(const int start[2], const int taskPos[][2], int n, int order[],
+                           long long* evaluations = nullptr);
+
+#endif //LARGETOURSOLVER_H
@@ -0,0 +1,284 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * Authors: Andy, Patrick, Kaicheng
+ * File: NameIndex.cpp
+ * Purpose:
+ *   Implements NameIndex: front-coded blocks of sorted (name, slot) entries
+ *   with binary-search exact/prefix lookup and a shared-prefix edit-distance
+ *   scan.
+ *
+ * Notes:
+ *   - Lookups binary search the blocks by their first (whole) name, then
+ *     decode one block front to back. Inserts and removes re-encode only
+ *     the block they touch; a block splits in two past 2 * BLOCK_ENTRIES.
+ *   - The fuzzy scan keeps one Levenshtein row per character of the current
+ *     name. Moving to the next entry only recomputes rows past the prefix
+ *     both names share, and once every cell of a row exceeds maxEdits, all
+ *     following names with that same prefix are skipped without any work.
+ */
+
+#include "NameIndex.h"
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace {
+
+// Characters a and b have in common at the front
+int commonPrefix(const string& a, const string& b) {
+    size_t n = min(a.size(), b.size());
+    size_t k = 0;
+    while (k < n && a[k] == b[k]) ++k;
+    return static_cast<int>(k);
+}
+
+// (name, slot) ordering used throughout the index
+bool entryLess(const string& nameA, int slotA, const string& nameB, int slotB) {
+    int c = nameA.compare(nameB);
+    return c < 0 || (c == 0 && slotA < slotB);
+}
+
+} // namespace
+
+NameIndex::NameIndex() : count(0) {}
+
+// Last block whose first entry is not after (name, slot)
+size_t NameIndex::findBlock(const string& name, int slot) const {
+    size_t left = 0;
+    size_t right = blocks.size();
+    while (left < right) {
+        size_t mid = left + (right - left) / 2;
+        const Entry& first = blocks[mid].entries[0];
+        if (entryLess(name, slot, first.suffix, first.slot)) {
+            right = mid;
+        } else {
+            left = mid + 1;
+        }
+    }
+    return left > 0 ? left - 1 : 0;
+}
+
+// Expands a block into whole names and slots
+void NameIndex::decodeBlock(const Block& block, vector<string>& names, vector<int>& slots) {
+    names.resize(block.entries.size());
+    slots.resize(block.entries.size());
+    for (size_t i = 0; i < block.entries.size(); ++i) {
+        const Entry& e = block.entries[i];
+        if (i == 0) {
+            names[i] = e.suffix;
+        } else {
+            names[i].assign(names[i - 1], 0, e.sharedPrefix);
+            names[i] += e.suffix;
+        }
+        slots[i] = e.slot;
+    }
+}
+
+// Front-codes names[first, last) into block
+void NameIndex::encodeBlock(Block& block, const vector<string>& names, const vector<int>& slots,
+                            size_t first, size_t last) {
+    block.entries.resize(last - first);
+    for (size_t i = first; i < last; ++i) {
+        Entry& e = block.entries[i - first];
+        e.sharedPrefix = (i == first) ? 0 : commonPrefix(names[i - 1], names[i]);
+        e.suffix.assign(names[i], e.sharedPrefix, string::npos);
+        e.slot = slots[i];
+    }
+    block.entries.shrink_to_fit();
+}
+
+// Visits entries from block b on with their whole names
+template <typename Visit>
+void NameIndex::scanFrom(size_t b, Visit visit) const {
+    string name;
+    bool first = true;
+    for (; b < blocks.size(); ++b) {
+        const vector<Entry>& entries = blocks[b].entries;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const Entry& e = entries[i];
+            int shared;
+            if (i == 0) {
+                // Block heads are stored whole; recover the shared prefix
+                shared = first ? 0 : commonPrefix(name, e.suffix);
+                name = e.suffix;
+            } else {
+                shared = e.sharedPrefix;
+                name.resize(shared);
+                name += e.suffix;
+            }
+            first = false;
+            if (!visit(name, e.slot, shared)) return;
+        }
+    }
+}
+
+// Rebuilds the whole index from the fleet
+void NameIndex::rebuild(const DroneStore& drones) {
+    vector<pair<string, int> > sorted(drones.size());
+    for (int i = 0; i < drones.size(); ++i) {
+        sorted[i] = make_pair(drones[i].getName(), i);
+    }
+    sort(sorted.begin(), sorted.end());
+
+    vector<string> names(sorted.size());
+    vector<int> slots(sorted.size());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        names[i].swap(sorted[i].first);
+        slots[i] = sorted[i].second;
+    }
+    blocks.assign((names.size() + BLOCK_ENTRIES - 1) / BLOCK_ENTRIES, Block());
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        size_t first = b * BLOCK_ENTRIES;
+        encodeBlock(blocks[b], names, slots, first, min(names.size(), first + BLOCK_ENTRIES));
+    }
+    count = static_cast<int>(names.size());
+}
+
+// Adds one name for a slot
+void NameIndex::insert(const string& name, int slot) {
+    // An empty index has no block head for findBlock to compare against
+    size_t b = 0;
+    if (blocks.empty()) {
+        blocks.push_back(Block());
+    } else {
+        b = findBlock(name, slot);
+    }
+    vector<string> names;
+    vector<int> slots;
+    decodeBlock(blocks[b], names, slots);
+
+    size_t pos = 0;
+    while (pos < names.size() && entryLess(names[pos], slots[pos], name, slot)) ++pos;
+    names.insert(names.begin() + pos, name);
+    slots.insert(slots.begin() + pos, slot);
+
+    if (names.size() > 2 * static_cast<size_t>(BLOCK_ENTRIES)) {
+        size_t half = names.size() / 2;
+        encodeBlock(blocks[b], names, slots, 0, half);
+        Block upper;
+        encodeBlock(upper, names, slots, half, names.size());
+        blocks.insert(blocks.begin() + b + 1, upper);
+    } else {
+        encodeBlock(blocks[b], names, slots, 0, names.size());
+    }
+    ++count;
+}
+
+// Removes one name for a slot
+void NameIndex::remove(const string& name, int slot) {
+    if (blocks.empty()) return;
+    size_t b = findBlock(name, slot);
+    vector<string> names;
+    vector<int> slots;
+    decodeBlock(blocks[b], names, slots);
+
+    for (size_t pos = 0; pos < names.size(); ++pos) {
+        if (names[pos] == name && slots[pos] == slot) {
+            names.erase(names.begin() + pos);
+            slots.erase(slots.begin() + pos);
+            if (names.empty()) {
+                blocks.erase(blocks.begin() + b);
+            } else {
+                encodeBlock(blocks[b], names, slots, 0, names.size());
+            }
+            --count;
+            return;
+        }
+    }
+}
+
+int NameIndex::size() const {
+    return count;
+}
+
+// Characters kept in suffixes versus whole names
+void NameIndex::getStoredChars(long long& stored, long long& whole) const {
+    stored = 0;
+    whole = 0;
+    scanFrom(0, [&](const string& name, int, int) {
+        whole += static_cast<long long>(name.size());
+        return true;
+    });
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        for (size_t i = 0; i < blocks[b].entries.size(); ++i) {
+            stored += static_cast<long long>(blocks[b].entries[i].suffix.size());
+        }
+    }
+}
+
+// Slot of an exact name match, or -1
+int NameIndex::find(const string& name) const {
+    int found = -1;
+    scanFrom(findBlock(name, -1), [&](const string& current, int slot, int) {
+        if (current < name) return true;
+        if (current == name) found = slot;
+        return false;
+    });
+    return found;
+}
+
+// Appends slots of every name starting with prefix
+void NameIndex::findPrefix(const string& prefix, vector<int>& slots) const {
+    scanFrom(findBlock(prefix, -1), [&](const string& name, int slot, int) {
+        if (name < prefix) return true;
+        if (name.compare(0, prefix.size(), prefix) != 0) return false;
+        slots.push_back(slot);
+        return true;
+    });
+}
+
+// Appends slots of every name within maxEdits of query
+void NameIndex::findFuzzy(const string& query, int maxEdits, vector<int>& slots) const {
+    int q = static_cast<int>(query.size());
+    int width = q + 1;
+
+    // rows[d * width + j] = edit distance between the first d characters of
+    // the current name and the first j characters of query
+    vector<int> rows(width);
+    for (int j = 0; j <= q; ++j) rows[j] = j;
+    int validDepth = 0;   // rows 0..validDepth belong to the current name
+    int deadDepth = -1;   // first row whose every cell exceeds maxEdits, or -1
+
+    scanFrom(0, [&](const string& name, int slot, int sharedPrefix) {
+        int m = static_cast<int>(name.size());
+        // Only rows inside the prefix shared with the previous name survive
+        validDepth = min(sharedPrefix, validDepth);
+
+        // The shared prefix already ruled this name out
+        if (deadDepth != -1 && deadDepth <= validDepth) {
+            return true;
+        }
+        deadDepth = -1;
+
+        // Length difference alone is a lower bound on the distance
+        if (m - q > maxEdits || q - m > maxEdits) {
+            return true;
+        }
+
+        if (static_cast<int>(rows.size()) < (m + 1) * width) {
+            rows.resize((m + 1) * width);
+        }
+        int d = validDepth + 1;
+        for (; d <= m; ++d) {
+            int* row = &rows[d * width];
+            const int* prev = &rows[(d - 1) * width];
+            row[0] = d;
+            int rowMin = row[0];
+            for (int j = 1; j <= q; ++j) {
+                int cost = (name[d - 1] == query[j - 1]) ? 0 : 1;
+                row[j] = min(min(prev[j] + 1, row[j - 1] + 1), prev[j - 1] + cost);
+                rowMin = min(rowMin, row[j]);
+            }
+            if (rowMin > maxEdits) {
+                deadDepth = d;
+                break;
+            }
+        }
+        validDepth = (deadDepth != -1) ? deadDepth : m;
+        if (deadDepth == -1 && rows[m * width + q] <= maxEdits) {
+            slots.push_back(slot);
+        }
+        return true;
+    });
+}
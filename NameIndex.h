@@ -0,0 +1,84 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * File: NameIndex.h
+ * Purpose:
+ *   Declares NameIndex: a sorted, front-coded array of (name, drone slot)
+ *   entries kept next to the Depot fleet. It answers exact, prefix and
+ *   bounded edit-distance lookups without re-sorting the fleet. Entries are
+ *   grouped in blocks; the first entry of a block stores its whole name and
+ *   every other entry stores only the characters after the prefix it shares
+ *   with the previous name. The fuzzy search reuses edit-distance rows across
+ *   that shared prefix (like walking a trie).
+ */
+
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include <string>
+#include <vector>
+#include "Drone.h"
+#include "DroneStore.h"
+
+using namespace std;
+
+// NameIndex class definition
+class NameIndex {
+private:
+    // Entries per block after a rebuild; a block splits past twice this
+    static const int BLOCK_ENTRIES = 32;
+
+    // One indexed name and the fleet slot that holds it. The name is the
+    // previous entry's first sharedPrefix characters followed by suffix
+    struct Entry {
+        string suffix;
+        int slot;
+        int sharedPrefix; // 0 for the first entry of a block (whole name)
+    };
+
+    // A run of consecutive entries; binary search only decodes one block
+    struct Block {
+        vector<Entry> entries;
+    };
+
+    // Blocks in (name, slot) order
+    vector<Block> blocks;
+    int count;
+
+    // Block that would hold (name, slot): the last one starting at or
+    // before it (0 if none)
+    size_t findBlock(const string& name, int slot) const;
+    // Expands a block into whole names and slots
+    static void decodeBlock(const Block& block, vector<string>& names, vector<int>& slots);
+    // Front-codes names[first, last) into block
+    static void encodeBlock(Block& block, const vector<string>& names, const vector<int>& slots,
+                            size_t first, size_t last);
+    // Calls visit(name, slot, sharedPrefix) for each entry from block b on,
+    // in order, until visit returns false; sharedPrefix is counted against
+    // the previous visited name, across block boundaries too
+    template <typename Visit>
+    void scanFrom(size_t b, Visit visit) const;
+
+public:
+    NameIndex();
+
+    // Rebuilds the whole index from the fleet (slot = store position)
+    void rebuild(const DroneStore& drones);
+    // Adds one name for a slot
+    void insert(const string& name, int slot);
+    // Removes one name for a slot (no-op if absent)
+    void remove(const string& name, int slot);
+    // Number of indexed names
+    int size() const;
+    // Characters stored for names, and what storing every name whole would take
+    void getStoredChars(long long& stored, long long& whole) const;
+
+    // Slot of an exact name match (lowest slot on ties), or -1
+    int find(const string& name) const;
+    // Appends slots of every name starting with prefix, in name order
+    void findPrefix(const string& prefix, vector<int>& slots) const;
+    // Appends slots of every name within maxEdits insertions, deletions or
+    // substitutions of query, in name order
+    void findFuzzy(const string& query, int maxEdits, vector<int>& slots) const;
+};
+
+#endif //NAMEINDEX_H
@@ -0,0 +1,208 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * Authors: Andy, Patrick, Kaicheng
+ * File: RouteJobs.cpp
+ * Purpose:
+ *   Implements RouteJobQueue: the worker pool, job bookkeeping, progress
+ *   listing, cancellation and result collection.
+ *
+ * Notes:
+ *   - Each job runs the exact solver on one thread; concurrency comes from
+ *     running several jobs at once.
+ */
+
+#include "RouteJobs.h"
+#include <iomanip>
+#include <limits>
+
+using namespace std;
+
+namespace {
+
+const char* stateName(RouteJobState state) {
+    switch (state) {
+    case JOB_QUEUED: return "queued";
+    case JOB_RUNNING: return "running";
+    case JOB_DONE: return "done";
+    default: return "cancelled";
+    }
+}
+
+} // namespace
+
+// Constructor: starts the worker pool
+RouteJobQueue::RouteJobQueue(int numWorkers) : shuttingDown(false), nextId(1) {
+    if (numWorkers < 1) numWorkers = 1;
+    for (int i = 0; i < numWorkers; ++i) {
+        workers.emplace_back(&RouteJobQueue::workerLoop, this);
+    }
+}
+
+// Destructor: stops running searches and joins the workers
+RouteJobQueue::~RouteJobQueue() {
+    {
+        lock_guard<mutex> guard(lock);
+        shuttingDown = true;
+        for (map<int, shared_ptr<Job> >::iterator it = jobs.begin(); it != jobs.end(); ++it) {
+            it->second->progress.cancel = true;
+        }
+    }
+    ready.notify_all();
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+}
+
+// Queues an exact route search on a copy of d's positions
+int RouteJobQueue::submit(const Drone& d, const string& label) {
+    int start[2] = { d.getInitPosition(0), d.getInitPosition(1) };
+    vector<int> taskPos(10);
+    for (int i = 0; i < 5; ++i) {
+        taskPos[2 * i] = d.getTaskPosition(i, 0);
+        taskPos[2 * i + 1] = d.getTaskPosition(i, 1);
+    }
+    return submit(start, taskPos, label);
+}
+
+// Queues an exact route search on a copy of the given points
+int RouteJobQueue::submit(const int start[2], const vector<int>& taskPos, const string& label) {
+    shared_ptr<Job> job = make_shared<Job>();
+    RouteJobResult& r = job->result;
+    r.label = label;
+    r.state = JOB_QUEUED;
+    r.start[0] = start[0];
+    r.start[1] = start[1];
+    r.taskPos = taskPos;
+    r.length = 0.0;
+    r.statesExplored = 0;
+    r.elapsedMs = 0.0;
+
+    int id;
+    {
+        lock_guard<mutex> guard(lock);
+        id = nextId++;
+        r.id = id;
+        jobs[id] = job;
+        waiting.push_back(job);
+    }
+    ready.notify_one();
+    return id;
+}
+
+// Runs queued jobs until the queue shuts down
+void RouteJobQueue::workerLoop() {
+    while (true) {
+        shared_ptr<Job> job;
+        {
+            unique_lock<mutex> guard(lock);
+            ready.wait(guard, [this]() { return shuttingDown || !waiting.empty(); });
+            if (shuttingDown) return;
+            job = waiting.front();
+            waiting.pop_front();
+            job->result.state = JOB_RUNNING;
+            job->started = chrono::steady_clock::now();
+        }
+
+        RouteJobResult& r = job->result;
+        int n = static_cast<int>(r.taskPos.size() / 2);
+        vector<int> order(n);
+        const int (*taskPos)[2] = reinterpret_cast<const int (*)[2]>(r.taskPos.data());
+        bool stoppedEarly = false;
+        double length = solveOptimalRoute(r.start, taskPos, n, order.data(), 1, nullptr, &job->progress,
+                                          &stoppedEarly);
+
+        lock_guard<mutex> guard(lock);
+        r.order = order;
+        r.length = length;
+        r.statesExplored = job->progress.statesExplored.load();
+        r.elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - job->started).count();
+        // A cancel that arrived after the search finished leaves an exact result
+        r.state = stoppedEarly ? JOB_CANCELLED : JOB_DONE;
+    }
+}
+
+// Asks a queued or running job to stop
+bool RouteJobQueue::cancel(int id) {
+    lock_guard<mutex> guard(lock);
+    map<int, shared_ptr<Job> >::iterator it = jobs.find(id);
+    if (it == jobs.end()) return false;
+    Job& job = *it->second;
+    if (job.result.state == JOB_QUEUED) {
+        for (deque<shared_ptr<Job> >::iterator w = waiting.begin(); w != waiting.end(); ++w) {
+            if (*w == it->second) {
+                waiting.erase(w);
+                break;
+            }
+        }
+        job.result.state = JOB_CANCELLED;
+        return true;
+    }
+    if (job.result.state == JOB_RUNNING) {
+        job.progress.cancel = true;
+        return true;
+    }
+    return false;
+}
+
+// Hands back a finished or cancelled job and forgets it
+bool RouteJobQueue::collect(int id, RouteJobResult& result) {
+    lock_guard<mutex> guard(lock);
+    map<int, shared_ptr<Job> >::iterator it = jobs.find(id);
+    if (it == jobs.end()) return false;
+    RouteJobState state = it->second->result.state;
+    if (state != JOB_DONE && state != JOB_CANCELLED) return false;
+    result = it->second->result;
+    jobs.erase(it);
+    return true;
+}
+
+// Lists every job with its live progress
+void RouteJobQueue::printJobs(ostream& out) {
+    lock_guard<mutex> guard(lock);
+    if (jobs.empty()) {
+        out << "No route jobs." << endl;
+        return;
+    }
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << fixed << setprecision(2);
+    for (map<int, shared_ptr<Job> >::iterator it = jobs.begin(); it != jobs.end(); ++it) {
+        const Job& job = *it->second;
+        const RouteJobResult& r = job.result;
+        out << "#" << r.id << " " << r.label << ": " << stateName(r.state);
+        if (r.state == JOB_RUNNING) {
+            double best = job.progress.bestLength.load();
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - job.started).count();
+            out << ", " << job.progress.statesExplored.load() << " states";
+            if (best < numeric_limits<double>::max()) out << ", best so far " << best;
+            out << ", " << ms << " ms";
+        } else if (r.state == JOB_DONE || (r.state == JOB_CANCELLED && !r.order.empty())) {
+            out << ", " << r.statesExplored << " states, length " << r.length << ", " << r.elapsedMs << " ms";
+        }
+        out << endl;
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+// Prints a collected route like Depot::computeOptimalRoute does
+void printRouteJobResult(const RouteJobResult& result, ostream& out) {
+    out << "[Route Job #" << result.id << " - " << result.label << "]" << endl;
+    if (result.order.empty()) {
+        out << "Cancelled before it started." << endl;
+        return;
+    }
+    const int* s = result.start;
+    out << "Sequence (starting at (" << s[0] << "," << s[1] << ")):" << endl;
+    out << "(" << s[0] << "," << s[1] << ")";
+    for (size_t i = 0; i < result.order.size(); ++i) {
+        int t = result.order[i];
+        out << " -> (" << result.taskPos[2 * t] << "," << result.taskPos[2 * t + 1] << ")";
+    }
+    out << " -> (" << s[0] << "," << s[1] << ")" << endl;
+    if (result.state == JOB_DONE) {
+        out << "Total distance (optimal): " << result.length << endl;
+    } else {
+        out << "Total distance (best before cancel): " << result.length << endl;
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * File: RouteJobs.h
+ * Purpose:
+ *   Declares RouteJobQueue: exact route searches run as background jobs so
+ *   the menu stays responsive. Each submitted job gets an ID, can be polled
+ *   for progress (states explored, best length so far), cancelled, and its
+ *   result collected later. Several jobs run at once on a small worker pool.
+ *
+ * Notes:
+ *   - A job copies the drone's positions when it is submitted; later edits
+ *     to the depot do not change a running job.
+ *   - Cancelling a queued job drops it; cancelling a running job stops the
+ *     search and keeps the best route found so far.
+ */
+
+#ifndef ROUTEJOBS_H
+#define ROUTEJOBS_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Drone.h"
+#include "RouteSolver.h"
+
+using namespace std;
+
+// Lifecycle of a route job
+enum RouteJobState { JOB_QUEUED, JOB_RUNNING, JOB_DONE, JOB_CANCELLED };
+
+// Finished (or cancelled) job handed back by collect()
+struct RouteJobResult {
+    int id;
+    string label;               // e.g. "drone 3 (Brandon)"
+    RouteJobState state;
+    int start[2];
+    vector<int> taskPos;        // x0 y0 x1 y1 ... (task i at 2i, 2i+1)
+    vector<int> order;          // visiting order of task indices (empty if never ran)
+    double length;
+    long long statesExplored;
+    double elapsedMs;
+};
+
+// RouteJobQueue class definition
+class RouteJobQueue {
+private:
+    // One job; progress is read by the menu while a worker writes it
+    struct Job {
+        RouteJobResult result;
+        RouteSearchProgress progress;
+        chrono::steady_clock::time_point started;
+    };
+
+    map<int, shared_ptr<Job> > jobs;   // every job not yet collected
+    deque<shared_ptr<Job> > waiting;   // queued jobs in submit order
+    mutex lock;
+    condition_variable ready;
+    vector<thread> workers;
+    bool shuttingDown;
+    int nextId;
+
+    void workerLoop();
+
+public:
+    // Starts numWorkers background workers (at least one)
+    explicit RouteJobQueue(int numWorkers);
+    // Cancels everything still running and joins the workers
+    ~RouteJobQueue();
+
+    // Queues an exact route search for drone d; returns the job ID
+    int submit(const Drone& d, const string& label);
+    // Same for any number of tasks (taskPos holds x0 y0 x1 y1 ...)
+    int submit(const int start[2], const vector<int>& taskPos, const string& label);
+    // Asks a job to stop; false if there is no such job or it already finished
+    bool cancel(int id);
+    // Removes a finished or cancelled job and returns it; false if the job
+    // is unknown or still queued/running
+    bool collect(int id, RouteJobResult& result);
+    // One line per job: ID, label, state, states explored, best length, time
+    void printJobs(ostream& out);
+};
+
+// Prints a collected job's route in the same layout as the route printers
+void printRouteJobResult(const RouteJobResult& result, ostream& out);
+
+#endif //ROUTEJOBS_H
@@ -0,0 +1,131 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * File: RouteKernels.h
+ * Purpose:
+ *   Declares exact route kernels specialised at compile time for small task
+ *   counts (N = 2..10). Each kernel keeps its distance table and search state
+ *   in fixed-size arrays on the stack, and the search depth is a template
+ *   parameter, so the compiler unrolls the recursion and no heap allocation
+ *   happens during a solve. solveOptimalRouteFixed() picks the kernel from
+ *   the runtime task count and falls back to the generic solver otherwise.
+ */
+
+#ifndef ROUTEKERNELS_H
+#define ROUTEKERNELS_H
+
+#include <cmath>
+#include <limits>
+#include "RouteSolver.h"
+
+using namespace std;
+
+// Smallest and largest task counts with a dedicated kernel
+const int MIN_FIXED_ROUTE_TASKS = 2;
+const int MAX_FIXED_ROUTE_TASKS = 10;
+
+// Exact closed-tour search for exactly N tasks
+template <int N>
+class FixedRouteKernel {
+private:
+    double dist[N + 1][N + 1]; // node 0 = start, node i + 1 = task i
+    double minEdge[N + 1];     // shortest edge leaving each node
+    bool used[N];
+    int path[N];
+    int bestPath[N];
+    double bestLength;
+    long long expanded;
+
+    // Places the stop at depth K; last is the node placed at depth K - 1
+    template <int K>
+    void place(double partial, int last, double unvisitedMinSum) {
+        ++expanded;
+        if constexpr (K == N) {
+            double length = partial + dist[last][0];
+            if (length < bestLength) {
+                bestLength = length;
+                for (int i = 0; i < N; ++i) bestPath[i] = path[i];
+            }
+        } else {
+            // Same lower bound as the generic solver: straight line home, or
+            // one shortest outgoing edge per node still to leave
+            double rest = minEdge[last] + unvisitedMinSum;
+            double bound = partial + (dist[last][0] > rest ? dist[last][0] : rest);
+            if (bound > bestLength + 1e-9) {
+                return;
+            }
+            for (int i = 0; i < N; ++i) {
+                if (used[i]) continue;
+                used[i] = true;
+                path[K] = i;
+                place<K + 1>(partial + dist[last][i + 1], i + 1, unvisitedMinSum - minEdge[i + 1]);
+                used[i] = false;
+            }
+        }
+    }
+
+public:
+    // Solves the tour; ties resolve to the lexicographically smallest order
+    double solve(const int start[2], const int taskPos[][2], int order[], long long* evaluations) {
+        for (int a = 0; a <= N; ++a) {
+            const int* pa = (a == 0) ? start : taskPos[a - 1];
+            for (int b = 0; b <= N; ++b) {
+                const int* pb = (b == 0) ? start : taskPos[b - 1];
+                double dx = static_cast<double>(pa[0] - pb[0]);
+                double dy = static_cast<double>(pa[1] - pb[1]);
+                dist[a][b] = sqrt(dx * dx + dy * dy);
+            }
+        }
+        double tasksMinSum = 0.0;
+        for (int a = 0; a <= N; ++a) {
+            minEdge[a] = numeric_limits<double>::max();
+            for (int b = 0; b <= N; ++b) {
+                if (a != b && dist[a][b] < minEdge[a]) minEdge[a] = dist[a][b];
+            }
+            if (a > 0) tasksMinSum += minEdge[a];
+        }
+        // Seed the bound with a nearest-neighbour tour; the optimum is never
+        // longer, so it is still found
+        for (int i = 0; i < N; ++i) used[i] = false;
+        bestLength = 0.0;
+        int current = 0;
+        for (int step = 0; step < N; ++step) {
+            int next = -1;
+            for (int j = 0; j < N; ++j) {
+                if (!used[j] && (next == -1 || dist[current][j + 1] < dist[current][next + 1])) next = j;
+            }
+            used[next] = true;
+            bestLength += dist[current][next + 1];
+            current = next + 1;
+        }
+        bestLength += dist[current][0] + 1e-9;
+        for (int i = 0; i < N; ++i) used[i] = false;
+        expanded = 0;
+
+        place<0>(0.0, 0, tasksMinSum);
+
+        for (int i = 0; i < N; ++i) order[i] = bestPath[i];
+        if (evaluations) *evaluations = expanded;
+        return bestLength;
+    }
+};
+
+// Exact tour using the kernel for n when one exists, else the generic
+// single-threaded solver. Same result as solveOptimalRoute(..., 1).
+inline double solveOptimalRouteFixed(const int start[2], const int taskPos[][2], int n, int order[],
+                                     long long* evaluations = nullptr) {
+    switch (n) {
+    case 2:  { FixedRouteKernel<2> k;  return k.solve(start, taskPos, order, evaluations); }
+    case 3:  { FixedRouteKernel<3> k;  return k.solve(start, taskPos, order, evaluations); }
+    case 4:  { FixedRouteKernel<4> k;  return k.solve(start, taskPos, order, evaluations); }
+    case 5:  { FixedRouteKernel<5> k;  return k.solve(start, taskPos, order, evaluations); }
+    case 6:  { FixedRouteKernel<6> k;  return k.solve(start, taskPos, order, evaluations); }
+    case 7:  { FixedRouteKernel<7> k;  return k.solve(start, taskPos, order, evaluations); }
+    case 8:  { FixedRouteKernel<8> k;  return k.solve(start, taskPos, order, evaluations); }
+    case 9:  { FixedRouteKernel<9> k;  return k.solve(start, taskPos, order, evaluations); }
+    case 10: { FixedRouteKernel<10> k; return k.solve(start, taskPos, order, evaluations); }
+    default:
+        return solveOptimalRoute(start, taskPos, n, order, 1, evaluations);
+    }
+}
+
+#endif //ROUTEKERNELS_H
@@ -0,0 +1,387 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * Authors: Andy, Patrick, Kaicheng
+ * File: RouteSolver.cpp
+ * Purpose:
+ *   Implements the shared route solvers on coordinate arrays.
+ *
+ * Notes:
+ *   - Node 0 of the distance matrix is the start point; task i is node i + 1.
+ *   - The exact solver hands out work items (fixed first two stops) from an
+ *     atomic counter, so idle workers keep pulling the next unsolved branch.
+ *   - Pruning only discards partial tours that are strictly longer than the
+ *     shared incumbent, so every optimal tour is still visited by its owner
+ *     and the per-item winners can be merged in item order.
+ */
+
+#include "RouteSolver.h"
+#include "RouteKernels.h"
+#include "LargeTourSolver.h"
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Slack for floating-point sums when comparing tour lengths
+const double LENGTH_EPSILON = 1e-9;
+
+// Search states a worker expands between progress reports / cancel checks
+const long long PROGRESS_INTERVAL = 4096;
+
+// Euclidean distance between two 2D points
+double pointDistance(const int pos1[2], const int pos2[2]) {
+    double x_diff = static_cast<double>(pos1[0] - pos2[0]);
+    double y_diff = static_cast<double>(pos1[1] - pos2[1]);
+    return sqrt(x_diff * x_diff + y_diff * y_diff);
+}
+
+// Data shared by all exact-search workers
+struct ExactSearch {
+    int n;                     // number of tasks
+    int nodes;                 // n + 1 (start point included)
+    vector<double> dist;       // nodes x nodes distance matrix
+    vector<double> minEdge;    // shortest edge leaving each node
+    atomic<double> incumbent;  // best tour length found by any worker
+    RouteSearchProgress* progress; // optional observer (may be null)
+
+    double d(int a, int b) const { return dist[a * nodes + b]; }
+
+    // Lowers the shared incumbent if length beats it
+    void offer(double length) {
+        double current = incumbent.load();
+        while (length < current && !incumbent.compare_exchange_weak(current, length)) {
+        }
+        if (progress) {
+            current = progress->bestLength.load();
+            while (length < current && !progress->bestLength.compare_exchange_weak(current, length)) {
+            }
+        }
+    }
+};
+
+// Per-worker DFS state for one work item
+struct ExactWorker {
+    ExactSearch* search;
+    vector<int> path;        // task indices placed so far
+    vector<char> used;       // used[i] = task i already placed
+    double bestLength;       // best complete tour inside this work item
+    vector<int> bestPath;
+    long long expanded;      // search states visited by this worker
+    bool stopped;            // cancel seen; unwind without searching further
+
+    // Extends path at depth k; partial is the length from start to path[k-1]
+    void extend(int k, double partial, double unvisitedMinSum) {
+        const ExactSearch& s = *search;
+        int last = path[k - 1] + 1;
+        if (stopped) return;
+        if (++expanded % PROGRESS_INTERVAL == 0 && s.progress) {
+            s.progress->statesExplored += PROGRESS_INTERVAL;
+            if (s.progress->cancel.load(memory_order_relaxed)) {
+                stopped = true;
+                return;
+            }
+        }
+
+        if (k == s.n) {
+            double length = partial + s.d(last, 0);
+            if (length < bestLength) {
+                bestLength = length;
+                bestPath = path;
+                search->offer(length);
+            }
+            return;
+        }
+
+        // Every remaining node still needs one outgoing edge, and the tour
+        // must get back to the start at least as far as the straight line
+        double bound = partial + max(s.d(last, 0), s.minEdge[last] + unvisitedMinSum);
+        if (bound > s.incumbent.load(memory_order_relaxed) + LENGTH_EPSILON) {
+            return;
+        }
+
+        for (int i = 0; i < s.n; ++i) {
+            if (used[i]) continue;
+            used[i] = 1;
+            path[k] = i;
+            extend(k + 1, partial + s.d(last, i + 1), unvisitedMinSum - s.minEdge[i + 1]);
+            used[i] = 0;
+        }
+    }
+};
+
+// Nearest-neighbour tour length, used to seed the incumbent
+double greedySeedLength(const ExactSearch& s) {
+    vector<char> visited(s.n, 0);
+    int current = 0;
+    double total = 0.0;
+    for (int step = 0; step < s.n; ++step) {
+        int best = -1;
+        for (int j = 0; j < s.n; ++j) {
+            if (!visited[j] && (best == -1 || s.d(current, j + 1) < s.d(current, best + 1))) {
+                best = j;
+            }
+        }
+        visited[best] = 1;
+        total += s.d(current, best + 1);
+        current = best + 1;
+    }
+    return total + s.d(current, 0);
+}
+
+} // namespace
+
+// Progress starts empty; bestLength is lowered as tours are found
+RouteSearchProgress::RouteSearchProgress()
+    : statesExplored(0), bestLength(numeric_limits<double>::max()), cancel(false) {}
+
+// Length of the closed tour visiting taskPos in the given order
+double computeTourLength(const int start[2], const int taskPos[][2], const int order[], int n) {
+    if (n <= 0) return 0.0;
+    double total = pointDistance(start, taskPos[order[0]]);
+    for (int i = 1; i < n; ++i) {
+        total += pointDistance(taskPos[order[i - 1]], taskPos[order[i]]);
+    }
+    return total + pointDistance(taskPos[order[n - 1]], start);
+}
+
+// Nearest-neighbour closed tour
+double solveGreedyRoute(const int start[2], const int taskPos[][2], int n, int order[], long long* evaluations) {
+    vector<char> visited(n, 0);
+    const int* currentPos = start;
+    long long examined = 0;
+    double totalDistance = 0.0;
+
+    for (int i = 0; i < n; ++i) {
+        double minDist = numeric_limits<double>::max();
+        int bestTaskIdx = -1;
+
+        // Find the closest unvisited task
+        for (int j = 0; j < n; ++j) {
+            if (!visited[j]) {
+                double dist = pointDistance(currentPos, taskPos[j]);
+                ++examined;
+                if (dist < minDist) {
+                    minDist = dist;
+                    bestTaskIdx = j;
+                }
+            }
+        }
+
+        // Visit the closest task
+        totalDistance += minDist;
+        order[i] = bestTaskIdx;
+        visited[bestTaskIdx] = 1;
+        currentPos = taskPos[bestTaskIdx];
+    }
+
+    if (evaluations) *evaluations = examined;
+    // Add distance to return to start
+    return (n > 0) ? totalDistance + pointDistance(currentPos, start) : 0.0;
+}
+
+// Exact closed tour, optionally split across several threads
+double solveOptimalRoute(const int start[2], const int taskPos[][2], int n, int bestOrder[], int numThreads,
+                         long long* evaluations, RouteSearchProgress* progress, bool* stoppedEarly) {
+    if (evaluations) *evaluations = 0;
+    if (stoppedEarly) *stoppedEarly = false;
+    if (n <= 0) return 0.0;
+    if (n == 1) {
+        bestOrder[0] = 0;
+        if (evaluations) *evaluations = 1;
+        return computeTourLength(start, taskPos, bestOrder, 1);
+    }
+
+    // Precompute all pairwise distances once
+    ExactSearch search;
+    search.n = n;
+    search.nodes = n + 1;
+    search.dist.assign(search.nodes * search.nodes, 0.0);
+    for (int a = 0; a < search.nodes; ++a) {
+        const int* pa = (a == 0) ? start : taskPos[a - 1];
+        for (int b = 0; b < search.nodes; ++b) {
+            const int* pb = (b == 0) ? start : taskPos[b - 1];
+            search.dist[a * search.nodes + b] = pointDistance(pa, pb);
+        }
+    }
+    search.minEdge.assign(search.nodes, numeric_limits<double>::max());
+    double allTasksMinSum = 0.0;
+    for (int a = 0; a < search.nodes; ++a) {
+        for (int b = 0; b < search.nodes; ++b) {
+            if (a != b && search.d(a, b) < search.minEdge[a]) {
+                search.minEdge[a] = search.d(a, b);
+            }
+        }
+        if (a > 0) allTasksMinSum += search.minEdge[a];
+    }
+    double seedLength = greedySeedLength(search);
+    search.incumbent.store(seedLength + LENGTH_EPSILON);
+    search.progress = progress;
+    if (progress) progress->bestLength.store(seedLength);
+
+    // One work item per ordered pair of first two stops
+    int numItems = n * (n - 1);
+    vector<double> itemLength(numItems, numeric_limits<double>::max());
+    vector<vector<int> > itemPath(numItems);
+    atomic<int> nextItem(0);
+    atomic<long long> totalExpanded(0);
+    atomic<bool> anyStopped(false);
+
+    auto runWorker = [&]() {
+        ExactWorker worker;
+        worker.search = &search;
+        worker.expanded = 0;
+        worker.stopped = false;
+        worker.path.assign(n, 0);
+        worker.used.assign(n, 0);
+
+        int item;
+        while (!worker.stopped && (item = nextItem.fetch_add(1)) < numItems) {
+            int first = item / (n - 1);
+            int second = item % (n - 1);
+            if (second >= first) ++second;
+
+            worker.bestLength = numeric_limits<double>::max();
+            worker.bestPath.clear();
+            worker.used[first] = worker.used[second] = 1;
+            worker.path[0] = first;
+            worker.path[1] = second;
+            double partial = search.d(0, first + 1) + search.d(first + 1, second + 1);
+            double unvisited = allTasksMinSum - search.minEdge[first + 1] - search.minEdge[second + 1];
+            worker.extend(2, partial, unvisited);
+            worker.used[first] = worker.used[second] = 0;
+
+            itemLength[item] = worker.bestLength;
+            itemPath[item] = worker.bestPath;
+        }
+        totalExpanded += worker.expanded;
+        if (worker.stopped) anyStopped = true;
+        if (progress) progress->statesExplored += worker.expanded % PROGRESS_INTERVAL;
+    };
+
+    if (numThreads <= 1) {
+        runWorker();
+    } else {
+        vector<thread> pool;
+        for (int t = 0; t < numThreads; ++t) {
+            pool.emplace_back(runWorker);
+        }
+        for (size_t t = 0; t < pool.size(); ++t) {
+            pool[t].join();
+        }
+    }
+
+    // Merge in item order so ties always pick the same tour
+    int bestItem = -1;
+    for (int item = 0; item < numItems; ++item) {
+        if (!itemPath[item].empty() && (bestItem == -1 || itemLength[item] < itemLength[bestItem])) {
+            bestItem = item;
+        }
+    }
+    if (evaluations) *evaluations = totalExpanded.load();
+    if (stoppedEarly) *stoppedEarly = anyStopped.load();
+    if (bestItem == -1) {
+        // Cancelled before anything beat the greedy seed
+        return solveGreedyRoute(start, taskPos, n, bestOrder);
+    }
+    for (int i = 0; i < n; ++i) {
+        bestOrder[i] = itemPath[bestItem][i];
+    }
+    return itemLength[bestItem];
+}
+
+// Removes and cheapest-reinserts one task, then 2-opts around it
+double repairRoute(const int start[2], const int taskPos[][2], int n, int order[], int changed, int window) {
+    if (n <= 0) return 0.0;
+
+    // Position p of the closed tour is start for p == -1 or p == n
+    auto stop = [&](int p) -> const int* {
+        return (p < 0 || p >= n) ? start : taskPos[order[p]];
+    };
+
+    // Take the changed task out of the order
+    int at = 0;
+    while (at < n && order[at] != changed) ++at;
+    if (at == n) return computeTourLength(start, taskPos, order, n);
+    for (int i = at; i < n - 1; ++i) order[i] = order[i + 1];
+
+    // Cheapest insertion among the n gaps of the (n-1)-stop tour
+    int m = n - 1;
+    int bestGap = 0;
+    double bestCost = numeric_limits<double>::max();
+    for (int g = 0; g <= m; ++g) {
+        const int* prev = (g == 0) ? start : taskPos[order[g - 1]];
+        const int* next = (g == m) ? start : taskPos[order[g]];
+        double cost = pointDistance(prev, taskPos[changed]) + pointDistance(taskPos[changed], next)
+                      - pointDistance(prev, next);
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestGap = g;
+        }
+    }
+    for (int i = m; i > bestGap; --i) order[i] = order[i - 1];
+    order[bestGap] = changed;
+
+    // Bounded 2-opt: reverse order[i..j] when it shortens the tour, only
+    // for i, j within the window around the inserted stop
+    int lo = max(0, bestGap - window);
+    int hi = min(n - 1, bestGap + window);
+    bool improved = true;
+    for (int pass = 0; improved && pass < window + 1; ++pass) {
+        improved = false;
+        for (int i = lo; i < hi; ++i) {
+            for (int j = i + 1; j <= hi; ++j) {
+                double before = pointDistance(stop(i - 1), stop(i)) + pointDistance(stop(j), stop(j + 1));
+                double after = pointDistance(stop(i - 1), stop(j)) + pointDistance(stop(i), stop(j + 1));
+                if (after < before - LENGTH_EPSILON) {
+                    for (int a = i, b = j; a < b; ++a, --b) swap(order[a], order[b]);
+                    improved = true;
+                }
+            }
+        }
+    }
+
+    return computeTourLength(start, taskPos, order, n);
+}
+
+// --- Solver Registry ---
+
+namespace {
+
+// Registry adapter: exact solver on the calling thread only
+double solveOptimalRouteSerial(const int start[2], const int taskPos[][2], int n, int order[], long long* evaluations) {
+    return solveOptimalRoute(start, taskPos, n, order, 1, evaluations);
+}
+
+// Registry adapter: compile-time kernel for small task counts
+double solveOptimalRouteFixedEntry(const int start[2], const int taskPos[][2], int n, int order[], long long* evaluations) {
+    return solveOptimalRouteFixed(start, taskPos, n, order, evaluations);
+}
+
+// Registry adapter: k-d tree nearest neighbour + Or-opt for large tours
+double solveLargeTourRouteEntry(const int start[2], const int taskPos[][2], int n, int order[], long long* evaluations) {
+    return solveLargeTourRoute(start, taskPos, n, order, evaluations);
+}
+
+// Registry adapter: greedy solver with the registry signature
+double solveGreedyRouteEntry(const int start[2], const int taskPos[][2], int n, int order[], long long* evaluations) {
+    return solveGreedyRoute(start, taskPos, n, order, evaluations);
+}
+
+} // namespace
+
+// All available solvers, in report order
+const vector<RouteSolverEntry>& getRouteSolvers() {
+    static const vector<RouteSolverEntry> solvers = {
+        { "greedy", solveGreedyRouteEntry },
+        { "optimal", solveOptimalRouteSerial },
+        { "optimal-fixed", solveOptimalRouteFixedEntry },
+        { "large-tour", solveLargeTourRouteEntry },
+    };
+    return solvers;
+}
@@ -0,0 +1,71 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * File: RouteSolver.h
+ * Purpose:
+ *   Declares the route solvers shared by the Depot and the batch modes.
+ *   Solvers work on plain coordinate arrays (start point + n task points) so
+ *   they are not tied to the 5-task Drone layout. A route is written as an
+ *   order of task indices; the tour always starts and ends at the start point.
+ */
+
+#ifndef ROUTESOLVER_H
+#define ROUTESOLVER_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Length of the closed tour start -> taskPos[order[0]] -> ... -> start
+double computeTourLength(const int start[2], const int taskPos[][2], const int order[], int n);
+
+// Nearest-neighbour closed tour: always move to the closest unvisited task
+// (ties go to the lower index). Returns the tour length. If evaluations is
+// not null it receives the number of candidate distances examined.
+double solveGreedyRoute(const int start[2], const int taskPos[][2], int n, int order[], long long* evaluations = nullptr);
+
+// Live view of an exact search for other threads: the solver publishes its
+// progress here and stops early once cancel is set
+struct RouteSearchProgress {
+    atomic<long long> statesExplored; // updated every few thousand states
+    atomic<double> bestLength;        // best closed tour known so far
+    atomic<bool> cancel;              // set by the caller to stop the search
+
+    RouteSearchProgress();
+};
+
+// Exact closed tour by branch and bound. The search is split by its first
+// two stops across numThreads workers that share the best length found so
+// far for pruning. Ties resolve to the lexicographically smallest order, so
+// the result does not depend on numThreads. Returns the tour length. If
+// evaluations is not null it receives the number of search states expanded.
+// If progress is not null the search reports into it; when cancelled it
+// returns the best tour found so far (at worst the greedy tour). If
+// stoppedEarly is not null it is set to whether the cancel actually cut the
+// search short, so a search that finished first still counts as exact.
+double solveOptimalRoute(const int start[2], const int taskPos[][2], int n, int bestOrder[], int numThreads,
+                         long long* evaluations = nullptr, RouteSearchProgress* progress = nullptr,
+                         bool* stoppedEarly = nullptr);
+
+// Repairs a kept closed route after task `changed` was inserted or moved:
+// the task is taken out of order[], put back at its cheapest insertion
+// point, and 2-opt moves are tried on the stops within `window` positions
+// of it. Costs O(n + window^2) instead of a full re-solve. Returns the new
+// tour length.
+double repairRoute(const int start[2], const int taskPos[][2], int n, int order[], int changed, int window);
+
+// --- Solver Registry ---
+// Common signature of every registered solver (single-threaded)
+typedef double (*RouteSolveFunc)(const int start[2], const int taskPos[][2], int n, int order[], long long* evaluations);
+
+// One named solver; new solvers are added to getRouteSolvers()
+struct RouteSolverEntry {
+    string name;
+    RouteSolveFunc solve;
+};
+
+// All available solvers, in report order
+const vector<RouteSolverEntry>& getRouteSolvers();
+
+#endif //ROUTESOLVER_H
@@ -0,0 +1,174 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * Authors: Andy, Patrick, Kaicheng
+ * File: SessionTrace.cpp
+ * Purpose:
+ *   Implements trace record I/O, the input-capturing TraceRecorder, and the
+ *   per-option latency report printed after a replay.
+ *
+ * Notes:
+ *   - The recorder's get area is one character, so every character the menu
+ *     reads (including whitespace a number parse only peeks at) is captured
+ *     exactly once. Interactive input is slow enough that this costs nothing.
+ */
+
+#include "SessionTrace.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+// Writes one record as a trace line
+void writeTraceRecord(ostream& out, const TraceRecord& record) {
+    out << record.offsetMicros << " " << record.serviceMicros << " " << record.option;
+    if (!record.args.empty()) out << " " << record.args;
+    out << "\n";
+}
+
+// Reads the next record; false at end of file
+bool readTraceRecord(istream& in, TraceRecord& record) {
+    string line;
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        istringstream fields(line);
+        if (!(fields >> record.offsetMicros >> record.serviceMicros >> record.option)) {
+            cout << "Error: Malformed trace line: " << line << endl;
+            continue;
+        }
+        // Everything after the option is the operation's input
+        getline(fields >> ws, record.args);
+        return true;
+    }
+    return false;
+}
+
+// --- TraceRecorder ---
+
+TraceRecorder::TraceRecorder(const string& path, istream& input)
+    : out(path), input(input), source(input.rdbuf()), current(0), recorded(0) {
+    sessionStart = chrono::steady_clock::now();
+    opStart = lastInput = sessionStart;
+    if (out.is_open()) {
+        out << "# depot session trace: offset_us service_us option args\n";
+        input.rdbuf(this);
+    } else {
+        cout << "Error: Could not open " << path << " for writing." << endl;
+    }
+}
+
+TraceRecorder::~TraceRecorder() {
+    if (out.is_open()) {
+        input.rdbuf(source);
+    }
+}
+
+bool TraceRecorder::isOpen() const {
+    return out.is_open();
+}
+
+// Pulls one character from the real input and remembers it
+TraceRecorder::int_type TraceRecorder::underflow() {
+    int_type c = source->sbumpc();
+    if (traits_type::eq_int_type(c, traits_type::eof())) return c;
+    current = traits_type::to_char_type(c);
+    captured.push_back(current);
+    lastInput = chrono::steady_clock::now();
+    setg(&current, &current, &current + 1);
+    return c;
+}
+
+// Marks the start of an operation
+void TraceRecorder::begin() {
+    captured.clear();
+    opStart = chrono::steady_clock::now();
+}
+
+// Writes the operation that began at begin()
+void TraceRecorder::end(int option) {
+    if (!out.is_open()) return;
+    chrono::steady_clock::time_point done = chrono::steady_clock::now();
+    chrono::steady_clock::time_point serviceStart = max(opStart, lastInput);
+
+    TraceRecord record;
+    record.offsetMicros = chrono::duration_cast<chrono::microseconds>(opStart - sessionStart).count();
+    record.serviceMicros = chrono::duration_cast<chrono::microseconds>(done - serviceStart).count();
+    record.option = option;
+
+    // Collapse the captured input to single-space separated tokens
+    istringstream tokens(captured);
+    string token;
+    while (tokens >> token) {
+        if (!record.args.empty()) record.args += " ";
+        record.args += token;
+    }
+    writeTraceRecord(out, record);
+    out.flush();
+    ++recorded;
+}
+
+int TraceRecorder::getRecordedCount() const {
+    return recorded;
+}
+
+// --- DiscardBuffer ---
+
+DiscardBuffer::int_type DiscardBuffer::overflow(int_type c) {
+    return traits_type::not_eof(c);
+}
+
+streamsize DiscardBuffer::xsputn(const char*, streamsize n) {
+    return n;
+}
+
+// --- Replay Report ---
+
+// Prints one summary line for a set of latencies (sorted in place)
+static void printLatencyLine(const string& label, vector<double>& micros, double recordedMean, ostream& out) {
+    sort(micros.begin(), micros.end());
+    auto percentile = [&](double p) { return micros[static_cast<size_t>(p * (micros.size() - 1))]; };
+    double sum = 0.0;
+    for (size_t i = 0; i < micros.size(); ++i) sum += micros[i];
+
+    out << label << "  count " << micros.size() << "  mean " << sum / micros.size()
+        << "  p50 " << percentile(0.50) << "  p90 " << percentile(0.90)
+        << "  p99 " << percentile(0.99) << "  max " << micros.back();
+    if (recordedMean >= 0.0) out << "  recorded mean " << recordedMean;
+    out << "\n";
+}
+
+// Per-option latency summary of a replay, then all operations together
+void printReplayReport(const map<int, vector<double> >& replayMicros,
+                       const map<int, vector<double> >& recordedMicros,
+                       double wallSeconds, ostream& out) {
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out.setf(ios::fixed);
+    out.precision(1);
+
+    vector<double> all;
+    out << "Latency us per option:\n";
+    for (map<int, vector<double> >::const_iterator it = replayMicros.begin(); it != replayMicros.end(); ++it) {
+        vector<double> micros = it->second;
+        all.insert(all.end(), micros.begin(), micros.end());
+
+        double recordedMean = -1.0;
+        map<int, vector<double> >::const_iterator rec = recordedMicros.find(it->first);
+        if (rec != recordedMicros.end() && !rec->second.empty()) {
+            double sum = 0.0;
+            for (size_t i = 0; i < rec->second.size(); ++i) sum += rec->second[i];
+            recordedMean = sum / rec->second.size();
+        }
+        printLatencyLine("  option " + to_string(it->first), micros, recordedMean, out);
+    }
+    if (all.empty()) {
+        out << "No operations replayed.\n";
+    } else {
+        printLatencyLine("  all      ", all, -1.0, out);
+        out << "Replayed " << all.size() << " operations in " << setprecision(3) << wallSeconds
+            << " s (" << setprecision(1) << (wallSeconds > 0.0 ? all.size() / wallSeconds : 0.0) << " ops/s)\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
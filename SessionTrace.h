@@ -0,0 +1,90 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * File: SessionTrace.h
+ * Purpose:
+ *   Declares the session trace used to turn interactive menu sessions into
+ *   repeatable performance tests. TraceRecorder captures every menu operation
+ *   (option number, the input it consumed, timing) to a trace file; the
+ *   replay side reads records back and summarises per-option latency.
+ *
+ * Trace format (text, one operation per line, '#' lines are comments):
+ *   <offset_us> <service_us> <option> <args...>
+ *   offset_us   time since the session started when the option was chosen
+ *   service_us  time from the operation's last input to its completion
+ *               (excludes the operator typing its arguments)
+ *   args        the input tokens the operation read, space separated
+ */
+
+#ifndef SESSIONTRACE_H
+#define SESSIONTRACE_H
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// One recorded menu operation
+struct TraceRecord {
+    long long offsetMicros;
+    long long serviceMicros;
+    int option;
+    string args;
+};
+
+// Writes one record as a trace line
+void writeTraceRecord(ostream& out, const TraceRecord& record);
+// Reads the next record, skipping comments and blank lines; false at end
+bool readTraceRecord(istream& in, TraceRecord& record);
+
+// TraceRecorder class definition: while alive, reads from the given input
+// stream pass through it so each operation's arguments can be captured
+class TraceRecorder : public streambuf {
+private:
+    ofstream out;
+    istream& input;
+    streambuf* source;
+    char current;                       // one-character get area
+    string captured;                    // input read since begin()
+    chrono::steady_clock::time_point sessionStart;
+    chrono::steady_clock::time_point opStart;
+    chrono::steady_clock::time_point lastInput;
+    int recorded;
+
+protected:
+    // Pulls one character from the real input and remembers it
+    int_type underflow() override;
+
+public:
+    // Starts a trace at path and captures everything read from input
+    TraceRecorder(const string& path, istream& input);
+    // Restores the input stream and closes the trace
+    ~TraceRecorder();
+
+    bool isOpen() const;
+    // Marks the start of an operation (after its option number was read)
+    void begin();
+    // Writes the operation that began at begin()
+    void end(int option);
+    // Number of operations written so far
+    int getRecordedCount() const;
+};
+
+// Output sink that drops everything (keeps replay timing free of console I/O)
+class DiscardBuffer : public streambuf {
+protected:
+    int_type overflow(int_type c) override;
+    streamsize xsputn(const char* s, streamsize n) override;
+};
+
+// Prints count, mean and p50/p90/p99/max latency per option, then overall.
+// recordedMicros holds each option's service times from the trace
+void printReplayReport(const map<int, vector<double> >& replayMicros,
+                       const map<int, vector<double> >& recordedMicros,
+                       double wallSeconds, ostream& out);
+
+#endif //SESSIONTRACE_H
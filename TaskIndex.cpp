@@ -0,0 +1,193 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * Authors: Andy, Patrick, Kaicheng
+ * File: TaskIndex.cpp
+ * Purpose:
+ *   Implements TaskIndex: the task-name inverted index and the spatial grid
+ *   over task positions.
+ *
+ * Notes:
+ *   - Every posting's position in its name list and cell list is kept in
+ *     spots, so removing one is swap-with-last and pop, O(1) however long
+ *     the list for a common task name grows.
+ */
+
+#include "TaskIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+namespace {
+
+// Orders postings by drone slot, then task slot
+bool postingLess(const TaskPosting& a, const TaskPosting& b) {
+    return a.droneSlot < b.droneSlot || (a.droneSlot == b.droneSlot && a.taskSlot < b.taskSlot);
+}
+
+} // namespace
+
+// Constructor: cellSize is the grid spacing in map units
+TaskIndex::TaskIndex(int cellSize) : cellSize(cellSize > 0 ? cellSize : 1) {}
+
+// Floor division so negative coordinates land in the right cell; done in
+// long long because negating INT_MIN does not fit in an int
+int TaskIndex::cellOf(int v) const {
+    long long wide = v;
+    long long cell = (wide >= 0) ? wide / cellSize : -((-wide + cellSize - 1) / cellSize);
+    return static_cast<int>(cell);
+}
+
+// Packs two cell coordinates into one hash key
+long long TaskIndex::packCell(int cx, int cy) {
+    // Shift the unsigned bit pattern; shifting a negative value is undefined
+    unsigned long long high = static_cast<unsigned long long>(static_cast<unsigned int>(cx)) << 32;
+    return static_cast<long long>(high | static_cast<unsigned int>(cy));
+}
+
+long long TaskIndex::cellKey(int x, int y) const {
+    return packCell(cellOf(x), cellOf(y));
+}
+
+TaskIndex::PostingSpot& TaskIndex::spotOf(const TaskPosting& posting) {
+    return spots[static_cast<size_t>(posting.droneSlot) * 5 + posting.taskSlot];
+}
+
+// Rebuilds both indexes from the fleet
+void TaskIndex::rebuild(const DroneStore& drones) {
+    byName.clear();
+    byCell.clear();
+    spots.assign(static_cast<size_t>(drones.size()) * 5, PostingSpot());
+    for (int i = 0; i < drones.size(); ++i) {
+        addDrone(drones[i], i);
+    }
+}
+
+// Adds postings for every non-empty task of d
+void TaskIndex::addDrone(const Drone& d, int slot) {
+    if (spots.size() < (static_cast<size_t>(slot) + 1) * 5) {
+        spots.resize((static_cast<size_t>(slot) + 1) * 5);
+    }
+    for (int t = 0; t < 5; ++t) {
+        string task = d.getTask(t);
+        if (task.empty()) continue;
+        TaskPosting posting = { slot, t };
+        PostingSpot& spot = spotOf(posting);
+        vector<TaskPosting>& named = byName[task];
+        spot.namePos = static_cast<int>(named.size());
+        named.push_back(posting);
+
+        GridEntry entry;
+        entry.x = d.getTaskPosition(t, 0);
+        entry.y = d.getTaskPosition(t, 1);
+        entry.posting = posting;
+        vector<GridEntry>& cell = byCell[cellKey(entry.x, entry.y)];
+        spot.cellPos = static_cast<int>(cell.size());
+        cell.push_back(entry);
+    }
+}
+
+// Removes the postings created for d at slot
+void TaskIndex::removeDrone(const Drone& d, int slot) {
+    if (spots.size() < (static_cast<size_t>(slot) + 1) * 5) return;
+    for (int t = 0; t < 5; ++t) {
+        string task = d.getTask(t);
+        if (task.empty()) continue;
+        TaskPosting posting = { slot, t };
+        const PostingSpot spot = spotOf(posting);
+
+        // Move the list's last posting into the freed position
+        unordered_map<string, vector<TaskPosting> >::iterator named = byName.find(task);
+        if (named != byName.end()) {
+            vector<TaskPosting>& list = named->second;
+            size_t i = static_cast<size_t>(spot.namePos);
+            if (i < list.size() && list[i].droneSlot == slot && list[i].taskSlot == t) {
+                list[i] = list.back();
+                spotOf(list[i]).namePos = spot.namePos;
+                list.pop_back();
+            }
+            if (list.empty()) byName.erase(named);
+        }
+
+        unordered_map<long long, vector<GridEntry> >::iterator cell =
+            byCell.find(cellKey(d.getTaskPosition(t, 0), d.getTaskPosition(t, 1)));
+        if (cell != byCell.end()) {
+            vector<GridEntry>& list = cell->second;
+            size_t i = static_cast<size_t>(spot.cellPos);
+            if (i < list.size() && list[i].posting.droneSlot == slot && list[i].posting.taskSlot == t) {
+                list[i] = list.back();
+                spotOf(list[i].posting).cellPos = spot.cellPos;
+                list.pop_back();
+            }
+            if (list.empty()) byCell.erase(cell);
+        }
+    }
+}
+
+// Postings for an exact task name
+void TaskIndex::findByName(const string& task, vector<TaskPosting>& results) const {
+    results.clear();
+    unordered_map<string, vector<TaskPosting> >::const_iterator named = byName.find(task);
+    if (named != byName.end()) {
+        results = named->second;
+    }
+    sort(results.begin(), results.end(), postingLess);
+}
+
+// Postings within radius of (x, y), checking only overlapping cells
+void TaskIndex::findWithinRadius(int x, int y, double radius, vector<TaskPosting>& results) const {
+    results.clear();
+    if (!(radius >= 0)) return; // negative or NaN
+    double radiusSq = radius * radius;
+
+    // Checks one cell's entries against the circle
+    auto scanCell = [&](const vector<GridEntry>& entries) {
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const GridEntry& e = entries[i];
+            // Subtract in double; e.x - x can overflow int at the extremes
+            double dx = static_cast<double>(e.x) - x;
+            double dy = static_cast<double>(e.y) - y;
+            if (dx * dx + dy * dy <= radiusSq) {
+                results.push_back(e.posting);
+            }
+        }
+    };
+
+    // Bounding box of the circle in cells. A box past the int range, or
+    // with more cells than are occupied, is cheaper to answer by scanning
+    // the occupied cells instead
+    double reach = ceil(radius);
+    double lowX = x - reach, highX = x + reach;
+    double lowY = y - reach, highY = y + reach;
+    bool scanAll = lowX < numeric_limits<int>::min() || highX > numeric_limits<int>::max()
+        || lowY < numeric_limits<int>::min() || highY > numeric_limits<int>::max();
+    int minCellX = 0, maxCellX = -1, minCellY = 0, maxCellY = -1;
+    if (!scanAll) {
+        minCellX = cellOf(static_cast<int>(lowX));
+        maxCellX = cellOf(static_cast<int>(highX));
+        minCellY = cellOf(static_cast<int>(lowY));
+        maxCellY = cellOf(static_cast<int>(highY));
+        // Each side can span 2^32 cells, so count in double
+        double boxCells = (static_cast<double>(maxCellX) - minCellX + 1)
+            * (static_cast<double>(maxCellY) - minCellY + 1);
+        scanAll = boxCells > static_cast<double>(byCell.size());
+    }
+    if (scanAll) {
+        for (unordered_map<long long, vector<GridEntry> >::const_iterator cell = byCell.begin(); cell != byCell.end(); ++cell) {
+            scanCell(cell->second);
+        }
+    } else {
+        // long long counters so a box ending at INT_MAX cannot overflow ++cx
+        for (long long cx = minCellX; cx <= maxCellX; ++cx) {
+            for (long long cy = minCellY; cy <= maxCellY; ++cy) {
+                unordered_map<long long, vector<GridEntry> >::const_iterator cell =
+                    byCell.find(packCell(static_cast<int>(cx), static_cast<int>(cy)));
+                if (cell != byCell.end()) {
+                    scanCell(cell->second);
+                }
+            }
+        }
+    }
+    sort(results.begin(), results.end(), postingLess);
+}
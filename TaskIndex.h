@@ -0,0 +1,78 @@
+/*
+ * Project: ESE224_Proj — Drone Depot
+ * File: TaskIndex.h
+ * Purpose:
+ *   Declares TaskIndex: task-level indexes kept next to the Depot fleet.
+ *   An inverted index maps each task name to its (drone slot, task slot)
+ *   postings, and a uniform grid over task positions answers "which stops
+ *   lie within r of (x, y)" by checking only the cells the circle touches.
+ *   Empty task slots (name "") are not indexed.
+ */
+
+#ifndef TASKINDEX_H
+#define TASKINDEX_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Drone.h"
+#include "DroneStore.h"
+
+using namespace std;
+
+// One indexed task: which drone slot and which of its task slots
+struct TaskPosting {
+    int droneSlot;
+    int taskSlot;
+};
+
+// TaskIndex class definition
+class TaskIndex {
+private:
+    // A posting plus the position it was indexed at
+    struct GridEntry {
+        int x;
+        int y;
+        TaskPosting posting;
+    };
+
+    // Where one posting sits in its name list and in its cell list
+    struct PostingSpot {
+        int namePos;
+        int cellPos;
+    };
+
+    // Side length of one grid cell, in map units
+    int cellSize;
+    unordered_map<string, vector<TaskPosting> > byName;
+    unordered_map<long long, vector<GridEntry> > byCell;
+    // Indexed by droneSlot * 5 + taskSlot, so removal never scans a list
+    vector<PostingSpot> spots;
+
+    // Spot of a posting (slot must have been added)
+    PostingSpot& spotOf(const TaskPosting& posting);
+
+    // Packs two cell coordinates into one hash key
+    static long long packCell(int cx, int cy);
+    // Key of the cell containing (x, y)
+    long long cellKey(int x, int y) const;
+    // Cell coordinate along one axis (floor division)
+    int cellOf(int v) const;
+
+public:
+    explicit TaskIndex(int cellSize = 8);
+
+    // Rebuilds both indexes from the fleet (slot = store position)
+    void rebuild(const DroneStore& drones);
+    // Adds postings for every non-empty task of drone d stored at slot
+    void addDrone(const Drone& d, int slot);
+    // Removes the postings addDrone(d, slot) created (d must be unchanged)
+    void removeDrone(const Drone& d, int slot);
+
+    // Postings for an exact task name, ordered by drone then task slot
+    void findByName(const string& task, vector<TaskPosting>& results) const;
+    // Postings whose position is within radius of (x, y), same order
+    void findWithinRadius(int x, int y, double radius, vector<TaskPosting>& results) const;
+};
+
+#endif //TASKINDEX_H
@@ -11,18 +11,73 @@
  *
  * Notes:
  *   - Option 10 swaps ONLY task names and task positions between two drones.
- *   - Options 17 (Local/Greedy) and 18 (Global/Optimal) print a route for a chosen drone.
+ *   - Option 17 (Local/Greedy) prints a route for a chosen drone. Option 18
+ *     (Global/Optimal) starts a background route job instead of blocking;
+ *     options 26-28 list job progress, cancel a job and collect its route
+ *     (see RouteJobs.h).
+ *   - Option 19 compares the drone's kept route (repaired after each task insert)
+ *     with a greedy route recomputed from scratch.
+ *   - Options 20 (prefix) and 21 (fuzzy) search names through the name index
+ *     without re-sorting the fleet, and page the matches 10 at a time.
+ *   - Options 22 (task name) and 23 (radius around a point) use the task index.
+ *   - Option 24 opens a what-if snapshot (see DepotSnapshot.h): edits go to an
+ *     O(1) copy of the fleet, show their route changes, then commit or discard.
+ *   - Option 25 applies a file of SWAP/COPY/INSERT edits as one batch
+ *     (Depot::applyEdits): all indices are checked first, and index and route
+ *     upkeep runs once per touched drone instead of once per edit.
+ *   - Option 29 prints bytes per drone and what 16-bit coordinates save;
+ *     build with -DDRONE_COMPACT_POSITIONS to store coordinates in 16 bits.
+ *     "--memory-report <input>" prints the same report for a whole file.
+ *   - Option 30 prints a drone's route from any registered solver, including
+ *     the large-tour heuristic; "--bench-large <stops> [layout]" times it
+ *     against greedy on uniform, clustered, repeated and outlying stops
+ *     (see LargeTourSolver.h).
  *   - No console pauses; actions return directly to the menu.
+ *   - "--stream <input> <output> [workers]" skips the menu and routes a fleet of
+ *     any size from input to output with bounded memory (see DroneStream.h).
+ *   - "--bench-exact <tasks> [threads]" times the exact solver on random tasks
+ *     with one thread and with several, and reports the speedup.
+ *   - "--report <input> <output.csv>" runs every route solver on every drone
+ *     in input and writes a CSV comparison (Depot::writeRouteReport).
+ *   - "--bench-kernels" compares the fixed-N route kernels with the generic
+ *     exact solver for N = 2..10.
+ *   - "--serve <socket> [input] [workers]" loads the fleet once and answers
+ *     requests on a Unix domain socket (see DepotServer.h; DepotLoadGen.cpp
+ *     is the matching load generator).
+ *   - "--record <trace>" runs the normal menu and logs every operation (option,
+ *     input it read, timing) to a trace file; "--replay <trace> [input]
+ *     [--paced]" re-runs a trace as fast as possible or at recorded pacing and
+ *     prints per-option latency percentiles (see SessionTrace.h).
  */
 
 #include "Depot.h"
 #include "Drone.h"
+#include "DroneStream.h"
+#include "RouteSolver.h"
+#include "RouteKernels.h"
+#include "LargeTourSolver.h"
+#include "DepotServer.h"
+#include "DepotSnapshot.h"
+#include "SessionTrace.h"
+#include "RouteJobs.h"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <chrono>
+#include <csignal>
+#include <random>
+#include <thread>
+#include <vector>
 using namespace std;
 
-// Loads up to 10 drones (each with 5 tasks) from the given text file.
+// Loads up to maxDrones drones (each with 5 tasks) from the given text file.
 // Expected format per drone:
 //   name id initX initY
 //   task1 x1 y1
@@ -30,44 +85,126 @@ using namespace std;
 //   task3 x3 y3
 //   task4 x4 y4
 //   task5 x5 y5
-void loadDronesFromFile(Depot& depot, const string& filename) {
+void loadDronesFromFile(Depot& depot, const string& filename, int maxDrones = 10) {
     ifstream infile(filename);
     if (!infile.is_open()) {
         cout << "Error: Could not open " << filename << endl;
         return;
     }
 
-    for (int i = 0; i < 10 && !infile.eof(); i++) {
+    vector<Drone> loaded;
+    for (int i = 0; i < maxDrones; i++) {
         Drone d;
-        string name;
-        int id;
-        int x, y;
+        infile >> ws;
+        if (infile.eof()) break;                 // stop early if no more records
+        if (!readDroneRecord(infile, d)) {
+            cout << "Error: Malformed drone record " << i + 1 << " in " << filename
+                 << "; loaded the " << loaded.size() << " before it." << endl;
+            break;
+        }
+        loaded.push_back(d);
+    }
+    infile.close();
+    depot.addDrones(loaded);                     // append to depot, index once
+}
 
-    infile >> name;             // read drone name
-    if (name.empty()) break;    // stop early if no more records
-    infile >> id;               // read drone ID
-    infile >> x >> y;           // read initial position (x,y)
+// Loads a batch of edits for Depot::applyEdits, one per line:
+//   SWAP <idx1> <idx2>
+//   COPY <src> <dest>
+//   INSERT <idx> <slot> <task> <x> <y>
+// Blank lines and lines starting with '#' are skipped.
+bool loadEditBatch(const string& filename, vector<DroneEdit>& edits) {
+    ifstream infile(filename);
+    if (!infile.is_open()) {
+        cout << "Error: Could not open " << filename << endl;
+        return false;
+    }
+    string line;
+    int lineNumber = 0;
+    while (getline(infile, line)) {
+        ++lineNumber;
+        istringstream fields(line);
+        string op;
+        if (!(fields >> op) || op[0] == '#') continue;
 
-    d.setName(name);            // set identity
-    d.setID(id);
-    d.setInitPosition(0, x);    // set initial X
-    d.setInitPosition(1, y);    // set initial Y
+        DroneEdit edit;
+        edit.index2 = edit.taskIdx = 0;
+        edit.taskPos[0] = edit.taskPos[1] = 0;
+        bool ok;
+        if (op == "SWAP" || op == "COPY") {
+            edit.type = (op == "SWAP") ? DroneEdit::SWAP_DATA : DroneEdit::COPY_DRONE;
+            ok = static_cast<bool>(fields >> edit.index1 >> edit.index2);
+        } else if (op == "INSERT") {
+            edit.type = DroneEdit::INSERT_TASK;
+            ok = static_cast<bool>(fields >> edit.index1 >> edit.taskIdx >> edit.task >> edit.taskPos[0] >> edit.taskPos[1]);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            cout << "Error: Bad edit on line " << lineNumber << " of " << filename << endl;
+            return false;
+        }
+        edits.push_back(edit);
+    }
+    return true;
+}
+
+// Shows search results one page at a time until the user enters 0.
+void browseResults(Depot& depot, const vector<int>& results, istream& in) {
+    const int pageSize = 10;
+    int pages = (static_cast<int>(results.size()) + pageSize - 1) / pageSize;
+    int page = 1;
+    while (true) {
+        depot.displayDronePage(results, page, pageSize, cout);
+        if (pages <= 1) break;
+        cout << "Enter page number (1-" << pages << ", 0 to return): ";
+        in >> page;
+        if (page == 0) break;
+    }
+}
 
-        for (int j = 0; j < 5; j++) {
+// Edits a what-if snapshot of the depot until the user commits or discards it.
+void runWhatIfSession(Depot& depot, istream& in) {
+    DepotSnapshot snap = depot.snapshot();  // O(1) fork; depot is untouched
+    while (true) {
+        cout << "\n--- What-If Snapshot ---\n";
+        cout << "1. Swap Drone Data  2. Insert Drone Task  3. Copy-Paste Drone\n";
+        cout << "4. Show Diff        5. Commit             6. Discard\n";
+        cout << "Select an option: ";
+        int choice;
+        if (!(in >> choice)) return;
+        if (choice == 1) {
+            int a, b;
+            cout << "Enter two indices to swap tasks between: ";
+            in >> a >> b;
+            if (snap.swapDroneData(a, b)) cout << "Swapped in snapshot.\n";
+        } else if (choice == 2) {
+            int droneIdx, taskIdx, tx, ty;
             string task;
-            int tx, ty;
-            infile >> task >> tx >> ty;   // read one task and its (x,y)
-            d.setTask(j, task);
-            d.setTaskPosition(j, 0, tx);
-            d.setTaskPosition(j, 1, ty);
+            cout << "Enter drone index, task index (0-4), task name and position (x y): ";
+            in >> droneIdx >> taskIdx >> task >> tx >> ty;
+            int pos[2] = { tx, ty };
+            if (snap.insertDroneTask(droneIdx, taskIdx, task, pos)) cout << "Task inserted in snapshot.\n";
+        } else if (choice == 3) {
+            int src, dest;
+            cout << "Enter source and destination indices: ";
+            in >> src >> dest;
+            if (snap.copyDrone(src, dest)) cout << "Drone copied in snapshot.\n";
+        } else if (choice == 4) {
+            snap.printDiff(cout);               // route totals before vs after
+        } else if (choice == 5) {
+            if (depot.commitSnapshot(snap)) cout << "Snapshot committed.\n";
+            return;
+        } else if (choice == 6) {
+            cout << "Snapshot discarded.\n";
+            return;
+        } else {
+            cout << "Invalid choice.\n";
         }
-
-    depot.addDrone(d);                 // append to depot
     }
-    infile.close();
 }
 
-// Prints the interactive menu of available actions (options 1–18).
+// Prints the interactive menu of available actions (options 1–30).
 void displayMenu() {
     cout << "\n===== DRONE CONTROL MENU =====\n";
     cout << "1. Sort Drones By Name\n";
@@ -87,190 +224,726 @@ void displayMenu() {
     cout << "15. SortDroneDataDescending\n";
     cout << "16. Quit\n";
     cout << "17. Local Optimum Route (Greedy)\n";
-    cout << "18. Global Optimum Route (Exact)\n";
+    cout << "18. Global Optimum Route (Exact, background job)\n";
+    cout << "19. Kept Route Drift (Repaired vs Greedy)\n";
+    cout << "20. Search Drones By Name Prefix\n";
+    cout << "21. Fuzzy Search Drones By Name\n";
+    cout << "22. Find Drones By Task Name\n";
+    cout << "23. Find Tasks Near A Point\n";
+    cout << "24. What-If Snapshot (edit, diff, commit/discard)\n";
+    cout << "25. Apply Edit Batch From File\n";
+    cout << "26. List Route Jobs (progress)\n";
+    cout << "27. Cancel Route Job\n";
+    cout << "28. Collect Route Job Result\n";
+    cout << "29. Drone Memory Report\n";
+    cout << "30. Route With Any Solver (greedy, optimal, large-tour, ...)\n";
     cout << "==============================\n";
     cout << "Select an option: ";
 }
 
-int main() {
-    Depot depot;
-    loadDronesFromFile(depot, "DroneInput.txt");
-    cout << "Loaded " << depot.getNumDrones() << " drones from DroneInput.txt.\n";
+// Background route workers: one per core, but at least two so jobs overlap
+int routeJobWorkers() {
+    return max(2, static_cast<int>(thread::hardware_concurrency()));
+}
 
-    
-    int choice;
-    do {
-    displayMenu();          // show menu
-    cin >> choice;          // read user selection
-        cout << endl;
+// Runs one menu option, reading its arguments from in (cin, or a trace
+// record during replay). Option 18 hands its search to routeJobs.
+void executeMenuOption(Depot& depot, RouteJobQueue& routeJobs, int choice, istream& in) {
+    /*
+    * Menu quick reference:
+    *  1) Sort by Name   2) Sort by ID   3) Sort by Position   4) Randomize
+    *  5) Add Drone      6) Show Drone   7) Search by Name     8) Search by ID
+    *  9) Write File    10) Swap Tasks  11) Insert Task       12) Copy Drone
+    * 13) List Names    14) Sort Tasks ↑ 15) Sort Tasks ↓     16) Quit
+    * 17) Local Route (Greedy)          18) Global Route (Optimal job)
+    * 19) Kept Route Drift              20) Prefix Search     21) Fuzzy Search
+    * 22) Drones By Task Name           23) Tasks Near Point
+    * 24) What-If Snapshot              25) Apply Edit Batch
+    * 26) List Route Jobs  27) Cancel Route Job  28) Collect Route Job
+    * 29) Memory Report                 30) Route With Any Solver
+    */
+    // Read-only options go through the const view so they never un-share
+    // drones that a what-if snapshot still holds
+    const Depot& reader = depot;
 
-        /*
-        * Menu quick reference:
-        *  1) Sort by Name   2) Sort by ID   3) Sort by Position   4) Randomize
-        *  5) Add Drone      6) Show Drone   7) Search by Name     8) Search by ID
-        *  9) Write File    10) Swap Tasks  11) Insert Task       12) Copy Drone
-        * 13) List Names    14) Sort Tasks ↑ 15) Sort Tasks ↓     16) Quit
-        * 17) Local Route (Greedy)          18) Global Route (Optimal)
-        */
-        
-        switch (choice) {
-        case 1:
-            depot.sortByName();                 // sort fleet by name (asc)
-            cout << "Sorted by name.\n";
-            break;
-        case 2:
-            depot.sortByID();                   // sort fleet by ID (asc)
-            cout << "Sorted by ID.\n";
-            break;
-        case 3:
-            depot.sortByPosition();             // sort by distance from origin (asc)
-            cout << "Sorted by distance from origin.\n";
-            break;
-        case 4:
-            depot.randomizeOrder();             // shuffle fleet order
-            cout << "Order randomized.\n";
-            break;
-        case 5: {
-            Drone d;
-            string name;
-            int id, x, y;
-            cout << "Enter drone name: ";
-            cin >> name;
-            cout << "Enter ID: ";
-            cin >> id;
-            cout << "Enter initial position (x y): ";
-            cin >> x >> y;
-            d.setName(name);
-            d.setID(id);
-            d.setInitPosition(0, x);
-            d.setInitPosition(1, y);
-            depot.addDrone(d);                  // add new drone to fleet
-            cout << "Drone added.\n";
+    switch (choice) {
+    case 1:
+        depot.sortByName();                 // sort fleet by name (asc)
+        cout << "Sorted by name.\n";
+        break;
+    case 2:
+        depot.sortByID();                   // sort fleet by ID (asc)
+        cout << "Sorted by ID.\n";
+        break;
+    case 3:
+        depot.sortByPosition();             // sort by distance from origin (asc)
+        cout << "Sorted by distance from origin.\n";
+        break;
+    case 4:
+        depot.randomizeOrder();             // shuffle fleet order
+        cout << "Order randomized.\n";
+        break;
+    case 5: {
+        Drone d;
+        string name;
+        int id, x, y;
+        cout << "Enter drone name: ";
+        in >> name;
+        cout << "Enter ID: ";
+        in >> id;
+        cout << "Enter initial position (x y): ";
+        in >> x >> y;
+        if (!Drone::positionFits(x) || !Drone::positionFits(y)) {
+            cout << "Position is outside the stored coordinate range.\n";
             break;
         }
-        case 6: {
-            int idx;
-            cout << "Enter drone index: ";
-            cin >> idx;
-            if (idx >= 0 && idx < depot.getNumDrones())
-                depot.getDrone(idx).displayDrone();   // show all attributes
-            else
-                cout << "Invalid index.\n";
-            break;
+        d.setName(name);
+        d.setID(id);
+        d.setInitPosition(0, x);
+        d.setInitPosition(1, y);
+        depot.addDrone(d);                  // add new drone to fleet
+        cout << "Drone added.\n";
+        break;
+    }
+    case 6: {
+        int idx;
+        cout << "Enter drone index: ";
+        in >> idx;
+        if (idx >= 0 && idx < depot.getNumDrones())
+            reader.getDrone(idx).displayDrone();  // show all attributes
+        else
+            cout << "Invalid index.\n";
+        break;
+    }
+    case 7: {
+        string name;
+        cout << "Enter name to search: ";
+        in >> name;
+        int idx = depot.findDroneByName(name);     // name index, fleet order kept
+        if (idx != -1)
+            reader.getDrone(idx).displayDrone();
+        else
+            cout << "Drone not found.\n";
+        break;
+    }
+    case 8: {
+        int id;
+        cout << "Enter ID to search: ";
+        in >> id;
+        int idx = depot.searchDroneByID(id);       // binary search by ID
+        if (idx != -1)
+            reader.getDrone(idx).displayDrone();
+        else
+            cout << "Drone not found.\n";
+        break;
+    }
+    case 9:
+        depot.writeDepotToFile();           // save snapshot to Depot.txt
+        cout << "Depot written to file.\n";
+        break;
+    case 10: {
+        int a, b;
+        cout << "Enter two indices to swap tasks between: ";
+        in >> a >> b;
+        if (a < 0 || b < 0 || a >= depot.getNumDrones() || b >= depot.getNumDrones()) { // bounds check
+            cout << "Invalid indices.\n";
+        } else if (a == b) {                // no-op if same index
+            cout << "Indices are the same; nothing to swap.\n";
+        } else if (depot.swapDroneData(a, b)) { // swap ONLY task names/positions
+            cout << "Swapped task data between drones " << a << " and " << b << "." << endl;
         }
-        case 7: {
-            string name;
-            cout << "Enter name to search: ";
-            cin >> name;
-            int idx = depot.searchDroneByName(name);   // binary search by name
-            if (idx != -1)
-                depot.getDrone(idx).displayDrone();
-            else
-                cout << "Drone not found.\n";
-            break;
+        break;
+    }
+    case 11: {
+        int droneIdx, taskIdx, tx, ty;
+        string task;
+        cout << "Enter drone index: ";
+        in >> droneIdx;
+        cout << "Enter task index (0-4): ";
+        in >> taskIdx;
+        cout << "Enter task name and position (x y): ";
+        in >> task >> tx >> ty;
+        int pos[2] = { tx, ty };            // pack (x,y) into array
+        if (depot.insertDroneTask(droneIdx, taskIdx, task, pos)) // insert/overwrite task
+            cout << "Task inserted.\n";
+        break;
+    }
+    case 12: {
+        int src, dest;
+        cout << "Enter source and destination indices: ";
+        in >> src >> dest;
+        if (depot.copyDrone(src, dest))     // deep copy src -> dest
+            cout << "Drone copied.\n";
+        break;
+    }
+    case 13:
+        depot.printAllNames();              // list indices and names
+        break;
+    case 14: {
+        int idx;
+        cout << "Enter drone index: ";
+        in >> idx;
+        depot.sortDroneDataAscending(idx);  // sort one drone's tasks A->Z
+        cout << "Drone tasks sorted ascending.\n";
+        break;
+    }
+    case 15: {
+        int idx;
+        cout << "Enter drone index: ";
+        in >> idx;
+        depot.sortDroneDataDescending(idx); // sort one drone's tasks Z->A
+        cout << "Drone tasks sorted descending.\n";
+        break;
+    }
+    case 16:
+        cout << "Exiting program.\n";
+        break;
+    case 17: {
+        if (depot.getNumDrones() == 0) { cout << "No drones loaded.\n"; break; }
+        int idx;
+        cout << "Enter drone index for Local (Greedy) route: ";
+        in >> idx;
+        if (idx >= 0 && idx < depot.getNumDrones()) {
+            depot.computeGreedyRoute(idx, cout);  // nearest-next closed tour
+        } else {
+            cout << "Invalid index.\n";
         }
-        case 8: {
-            int id;
-            cout << "Enter ID to search: ";
-            cin >> id;
-            int idx = depot.searchDroneByID(id);       // binary search by ID
-            if (idx != -1)
-                depot.getDrone(idx).displayDrone();
-            else
-                cout << "Drone not found.\n";
-            break;
+        break;
+    }
+    case 18: {
+        if (depot.getNumDrones() == 0) { cout << "No drones loaded.\n"; break; }
+        int idx;
+        cout << "Enter drone index for Global Optimal route: ";
+        in >> idx;
+        if (idx >= 0 && idx < depot.getNumDrones()) {
+            const Drone& d = reader.getDrone(idx);
+            int id = routeJobs.submit(d, "drone " + to_string(idx) + " (" + d.getName() + ")"); // runs in background
+            cout << "Started route job #" << id << " (options 26-28 to check, cancel, collect).\n";
+        } else {
+            cout << "Invalid index.\n";
         }
-        case 9:
-            depot.writeDepotToFile();           // save snapshot to Depot.txt
-            cout << "Depot written to file.\n";
-            break;
-        case 10: {
-            int a, b;
-            cout << "Enter two indices to swap tasks between: ";
-            cin >> a >> b;
-            if (a < 0 || b < 0 || a >= depot.getNumDrones() || b >= depot.getNumDrones()) { // bounds check
-                cout << "Invalid indices.\n";
-            } else if (a == b) {                // no-op if same index
-                cout << "Indices are the same; nothing to swap.\n";
-            } else {
-                depot.swapDroneData(a, b);      // swap ONLY task names/positions
+        break;
+    }
+    case 19: {
+        if (depot.getNumDrones() == 0) { cout << "No drones loaded.\n"; break; }
+        int idx;
+        cout << "Enter drone index for kept route drift: ";
+        in >> idx;
+        if (idx >= 0 && idx < depot.getNumDrones()) {
+            depot.printRouteDrift(idx, cout);     // repaired vs from-scratch
+        } else {
+            cout << "Invalid index.\n";
+        }
+        break;
+    }
+    case 20: {
+        string prefix;
+        cout << "Enter name prefix: ";
+        in >> prefix;
+        vector<int> results;
+        depot.findDronesByPrefix(prefix, results);   // index range scan
+        browseResults(depot, results, in);
+        break;
+    }
+    case 21: {
+        string name;
+        int maxEdits;
+        cout << "Enter name: ";
+        in >> name;
+        cout << "Enter max edits (e.g. 1 or 2): ";
+        in >> maxEdits;
+        vector<int> results;
+        depot.findDronesFuzzy(name, maxEdits, results); // bounded edit distance
+        browseResults(depot, results, in);
+        break;
+    }
+    case 22: {
+        string task;
+        cout << "Enter task name: ";
+        in >> task;
+        vector<TaskPosting> results;
+        depot.findDronesByTask(task, results);   // inverted index lookup
+        depot.printTaskPostings(results, cout);
+        break;
+    }
+    case 23: {
+        int x, y;
+        double radius;
+        cout << "Enter point (x y) and radius: ";
+        in >> x >> y >> radius;
+        vector<TaskPosting> results;
+        depot.findTasksNear(x, y, radius, results); // spatial grid lookup
+        depot.printTaskPostings(results, cout);
+        break;
+    }
+    case 24:
+        runWhatIfSession(depot, in);            // fork, edit, diff, commit/discard
+        break;
+    case 25: {
+        string filename;
+        cout << "Enter edit batch file: ";
+        in >> filename;
+        vector<DroneEdit> edits;
+        if (loadEditBatch(filename, edits) && depot.applyEdits(edits)) // all or nothing
+            cout << "Applied " << edits.size() << " edits.\n";
+        break;
+    }
+    case 26:
+        routeJobs.printJobs(cout);              // state, states explored, best so far
+        break;
+    case 27: {
+        int id;
+        cout << "Enter route job ID to cancel: ";
+        in >> id;
+        if (routeJobs.cancel(id))
+            cout << "Cancel requested for job #" << id << ".\n";
+        else
+            cout << "No queued or running job #" << id << ".\n";
+        break;
+    }
+    case 28: {
+        int id;
+        cout << "Enter route job ID to collect: ";
+        in >> id;
+        RouteJobResult result;
+        if (routeJobs.collect(id, result))
+            printRouteJobResult(result, cout);  // route found by the job
+        else
+            cout << "Job #" << id << " is unknown or still running.\n";
+        break;
+    }
+    case 29:
+        depot.printMemoryReport(cout);          // bytes per drone, compact savings
+        break;
+    case 30: {
+        if (depot.getNumDrones() == 0) { cout << "No drones loaded.\n"; break; }
+        const vector<RouteSolverEntry>& solvers = getRouteSolvers();
+        cout << "Solvers:";
+        for (size_t s = 0; s < solvers.size(); ++s) cout << " " << solvers[s].name;
+        cout << "\nEnter drone index and solver name: ";
+        int idx;
+        string solver;
+        in >> idx >> solver;
+        if (idx < 0 || idx >= depot.getNumDrones())
+            cout << "Invalid index.\n";
+        else if (!depot.computeSolverRoute(idx, solver, cout)) // registry lookup by name
+            cout << "Unknown solver.\n";
+        break;
+    }
+    default:
+        cout << "Invalid choice.\n";
+        break;
+    }
+}
+
+// Runs the streaming pipeline for "--stream <input> <output> [workers]".
+int runStreamMode(int argc, char* argv[]) {
+    if (argc < 4) {
+        cout << "Usage: " << argv[0] << " --stream <input> <output> [workers]\n";
+        return 1;
+    }
+    int workers = (argc >= 5) ? atoi(argv[4]) : static_cast<int>(thread::hardware_concurrency());
+    if (workers < 1) workers = 1;
+
+    ifstream infile(argv[2]);
+    if (!infile.is_open()) {
+        cout << "Error: Could not open " << argv[2] << endl;
+        return 1;
+    }
+    ofstream outFile(argv[3]);
+    if (!outFile.is_open()) {
+        cout << "Error: Could not open " << argv[3] << " for writing." << endl;
+        return 1;
+    }
+
+    // Queue depth of a few records per worker keeps every stage busy
+    long long badRecord = 0;
+    long long written = streamDepotRoutes(infile, outFile, workers, workers * 4, &badRecord);
+    outFile.close();
+    if (badRecord > 0) {
+        cout << "Error: Malformed drone record " << badRecord << " in " << argv[2]
+             << "; stopped after " << written << " drones." << endl;
+        return 1;
+    }
+    if (!outFile) {
+        cout << "Error: Failed writing " << argv[3] << " after " << written << " drones." << endl;
+        return 1;
+    }
+    cout << "Streamed " << written << " drones to " << argv[3] << " using " << workers << " workers.\n";
+    return 0;
+}
+
+// Runs "--bench-exact <tasks> [threads]": exact solver speedup versus one thread.
+int runBenchExactMode(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "Usage: " << argv[0] << " --bench-exact <tasks> [threads]\n";
+        return 1;
+    }
+    int n = atoi(argv[2]);
+    int threads = (argc >= 4) ? atoi(argv[3]) : static_cast<int>(thread::hardware_concurrency());
+    if (n < 2 || threads < 1) {
+        cout << "Invalid task count or thread count.\n";
+        return 1;
+    }
+
+    // Fixed seed so repeated runs time the same instance
+    mt19937 rng(224);
+    uniform_int_distribution<int> coord(0, 100);
+    int start[2] = { coord(rng), coord(rng) };
+    vector<int> flat(2 * n);
+    for (int i = 0; i < 2 * n; ++i) flat[i] = coord(rng);
+    const int (*taskPos)[2] = reinterpret_cast<const int (*)[2]>(flat.data());
+
+    vector<int> serialOrder(n), parallelOrder(n);
+    auto t0 = chrono::steady_clock::now();
+    double serialLength = solveOptimalRoute(start, taskPos, n, serialOrder.data(), 1);
+    auto t1 = chrono::steady_clock::now();
+    double parallelLength = solveOptimalRoute(start, taskPos, n, parallelOrder.data(), threads);
+    auto t2 = chrono::steady_clock::now();
+
+    double serialMs = chrono::duration<double, milli>(t1 - t0).count();
+    double parallelMs = chrono::duration<double, milli>(t2 - t1).count();
+    cout.setf(ios::fixed);
+    cout.precision(2);
+    cout << "Exact route, " << n << " tasks\n";
+    cout << "  1 thread:   " << serialMs << " ms, length " << serialLength << "\n";
+    cout << "  " << threads << " threads: " << parallelMs << " ms, length " << parallelLength << "\n";
+    cout << "  Speedup:    " << (parallelMs > 0.0 ? serialMs / parallelMs : 0.0) << "x\n";
+    cout << "  Same route: " << (serialOrder == parallelOrder ? "yes" : "NO") << "\n";
+    return serialOrder == parallelOrder ? 0 : 1;
+}
+
+// Runs "--report <input> <output.csv>": solver comparison for a whole fleet.
+int runReportMode(int argc, char* argv[]) {
+    if (argc < 4) {
+        cout << "Usage: " << argv[0] << " --report <input> <output.csv>\n";
+        return 1;
+    }
+    Depot depot;
+    loadDronesFromFile(depot, argv[2], numeric_limits<int>::max());
+
+    ofstream outFile(argv[3]);
+    if (!outFile.is_open()) {
+        cout << "Error: Could not open " << argv[3] << " for writing." << endl;
+        return 1;
+    }
+    depot.writeRouteReport(outFile);
+    cout << "Wrote route report for " << depot.getNumDrones() << " drones to " << argv[3] << ".\n";
+    return 0;
+}
+
+// Runs "--bench-kernels": per-N time of the fixed kernels vs the generic solver.
+int runBenchKernelsMode() {
+    const int instances = 64;
+    mt19937 rng(224);
+    uniform_int_distribution<int> coord(0, 100);
+    bool allMatch = true;
+
+    cout.setf(ios::fixed);
+    cout.precision(2);
+    cout << " N   generic us/solve   fixed us/solve   speedup\n";
+    for (int n = MIN_FIXED_ROUTE_TASKS; n <= MAX_FIXED_ROUTE_TASKS; ++n) {
+        // Fewer repetitions as the search grows factorially
+        int reps = (n <= 6) ? 200 : (n <= 8 ? 20 : 2);
+        vector<int> starts(2 * instances);
+        vector<int> flat(2 * n * instances);
+        for (size_t i = 0; i < starts.size(); ++i) starts[i] = coord(rng);
+        for (size_t i = 0; i < flat.size(); ++i) flat[i] = coord(rng);
+
+        double genericTotal = 0.0, fixedTotal = 0.0;
+        vector<int> order(n);
+        auto t0 = chrono::steady_clock::now();
+        for (int r = 0; r < reps; ++r) {
+            for (int k = 0; k < instances; ++k) {
+                const int (*taskPos)[2] = reinterpret_cast<const int (*)[2]>(&flat[2 * n * k]);
+                genericTotal += solveOptimalRoute(&starts[2 * k], taskPos, n, order.data(), 1);
             }
-            break;
         }
-        case 11: {
-            int droneIdx, taskIdx, tx, ty;
-            string task;
-            cout << "Enter drone index: ";
-            cin >> droneIdx;
-            cout << "Enter task index (0-4): ";
-            cin >> taskIdx;
-            cout << "Enter task name and position (x y): ";
-            cin >> task >> tx >> ty;
-            int pos[2] = { tx, ty };            // pack (x,y) into array
-            depot.insertDroneTask(droneIdx, taskIdx, task, pos); // insert/overwrite task
-            cout << "Task inserted.\n";
-            break;
+        auto t1 = chrono::steady_clock::now();
+        for (int r = 0; r < reps; ++r) {
+            for (int k = 0; k < instances; ++k) {
+                const int (*taskPos)[2] = reinterpret_cast<const int (*)[2]>(&flat[2 * n * k]);
+                fixedTotal += solveOptimalRouteFixed(&starts[2 * k], taskPos, n, order.data());
+            }
         }
-        case 12: {
-            int src, dest;
-            cout << "Enter source and destination indices: ";
-            cin >> src >> dest;
-            depot.copyDrone(src, dest);         // deep copy src -> dest
-            cout << "Drone copied.\n";
-            break;
+        auto t2 = chrono::steady_clock::now();
+
+        double solves = static_cast<double>(reps) * instances;
+        double genericUs = chrono::duration<double, micro>(t1 - t0).count() / solves;
+        double fixedUs = chrono::duration<double, micro>(t2 - t1).count() / solves;
+        cout << (n < 10 ? " " : "") << n << "   " << genericUs << "   " << fixedUs
+             << "   " << (fixedUs > 0.0 ? genericUs / fixedUs : 0.0) << "x\n";
+        if (genericTotal != fixedTotal) {
+            allMatch = false;
+            cout << "    length mismatch at N=" << n << "\n";
         }
-        case 13:
-            depot.printAllNames();              // list indices and names
-            break;
-        case 14: {
-            int idx;
-            cout << "Enter drone index: ";
-            cin >> idx;
-            depot.sortDroneDataAscending(idx);  // sort one drone's tasks A->Z
-            cout << "Drone tasks sorted ascending.\n";
-            break;
+    }
+    return allMatch ? 0 : 1;
+}
+
+// Fills flat (x0 y0 x1 y1 ...) with n stops in one --bench-large layout:
+//   uniform   spread over a square with ~100 units per stop
+//   clusters  two tight clusters far apart
+//   point     every stop at the same point
+//   outliers  one tight cluster plus 10 far stops
+// Returns false for an unknown layout.
+bool makeBenchLayout(const string& layout, int n, mt19937& rng, int start[2], vector<int>& flat) {
+    flat.assign(2 * n, 0);
+    if (layout == "uniform") {
+        int side = static_cast<int>(sqrt(100.0 * n)) + 1;
+        uniform_int_distribution<int> coord(0, side);
+        for (int i = 0; i < 2 * n; ++i) flat[i] = coord(rng);
+        start[0] = start[1] = side / 2;
+    } else if (layout == "clusters") {
+        uniform_int_distribution<int> jitter(0, 200);
+        for (int i = 0; i < n; ++i) {
+            int base = (i % 2 == 0) ? 0 : 1000000;
+            flat[2 * i] = base + jitter(rng);
+            flat[2 * i + 1] = base + jitter(rng);
         }
-        case 15: {
-            int idx;
-            cout << "Enter drone index: ";
-            cin >> idx;
-            depot.sortDroneDataDescending(idx); // sort one drone's tasks Z->A
-            cout << "Drone tasks sorted descending.\n";
-            break;
+        start[0] = start[1] = 500000;
+    } else if (layout == "point") {
+        for (int i = 0; i < 2 * n; ++i) flat[i] = 5000;
+        start[0] = start[1] = 0;
+    } else if (layout == "outliers") {
+        uniform_int_distribution<int> jitter(0, 200);
+        uniform_int_distribution<int> far(0, 1000000);
+        for (int i = 0; i < n; ++i) {
+            bool outlier = i < 10;
+            flat[2 * i] = outlier ? far(rng) : jitter(rng);
+            flat[2 * i + 1] = outlier ? far(rng) : jitter(rng);
         }
-        case 16:
-            cout << "Exiting program.\n";
-            break;
-        case 17: {
-            if (depot.getNumDrones() == 0) { cout << "No drones loaded.\n"; break; }
-            int idx;
-            cout << "Enter drone index for Local (Greedy) route: ";
-            cin >> idx;
-            if (idx >= 0 && idx < depot.getNumDrones()) {
-                depot.computeGreedyRoute(idx, cout);  // nearest-next closed tour
-            } else {
-                cout << "Invalid index.\n";
-            }
-            break;
+        start[0] = start[1] = 100;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Times large-tour against greedy on one layout; false if the tour is invalid
+bool benchLargeLayout(const string& layout, int n) {
+    // Greedy is O(n^2); past this it takes minutes
+    const int maxGreedyStops = 30000;
+
+    // Fixed seed so repeated runs time the same instance
+    mt19937 rng(224);
+    int start[2];
+    vector<int> flat;
+    makeBenchLayout(layout, n, rng, start, flat);
+    const int (*taskPos)[2] = reinterpret_cast<const int (*)[2]>(flat.data());
+
+    cout << "Layout " << layout << ", " << n << " stops\n";
+    cout << " solver        length          ms   evaluations\n";
+    double greedyLength = 0.0;
+    vector<int> order(n);
+    if (n <= maxGreedyStops) {
+        long long evaluations = 0;
+        auto t0 = chrono::steady_clock::now();
+        greedyLength = solveGreedyRoute(start, taskPos, n, order.data(), &evaluations);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        cout << " greedy        " << greedyLength << "   " << ms << "   " << evaluations << "\n";
+    } else {
+        cout << " greedy        skipped (O(n^2) above " << maxGreedyStops << " stops)\n";
+    }
+    if (n <= MAX_FIXED_ROUTE_TASKS) {
+        double exact = solveOptimalRouteFixed(start, taskPos, n, order.data());
+        cout << " optimal       " << exact << "\n";
+    }
+
+    long long evaluations = 0;
+    auto t0 = chrono::steady_clock::now();
+    double largeLength = solveLargeTourRoute(start, taskPos, n, order.data(), &evaluations);
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    cout << " large-tour    " << largeLength << "   " << ms << "   " << evaluations << "\n";
+    if (greedyLength > 0.0) {
+        cout << " large-tour vs greedy: " << 100.0 * (largeLength - greedyLength) / greedyLength << "%\n";
+    }
+
+    // The order must visit every stop exactly once
+    vector<char> seen(n, 0);
+    for (int i = 0; i < n; ++i) {
+        if (order[i] < 0 || order[i] >= n || seen[order[i]]) {
+            cout << " invalid tour\n";
+            return false;
         }
-        case 18: {
-            if (depot.getNumDrones() == 0) { cout << "No drones loaded.\n"; break; }
-            int idx;
-            cout << "Enter drone index for Global Optimal route: ";
-            cin >> idx;
-            if (idx >= 0 && idx < depot.getNumDrones()) {
-                depot.computeOptimalRoute(idx, cout); // brute-force closed tour
-            } else {
-                cout << "Invalid index.\n";
-            }
-            break;
+        seen[order[i]] = 1;
+    }
+    return true;
+}
+
+// Runs "--bench-large <stops> [layout]": large-tour heuristic vs greedy on
+// generated stops; every layout when none is given.
+int runBenchLargeMode(int argc, char* argv[]) {
+    const char* layouts[] = { "uniform", "clusters", "point", "outliers" };
+    if (argc < 3) {
+        cout << "Usage: " << argv[0] << " --bench-large <stops> [uniform|clusters|point|outliers]\n";
+        return 1;
+    }
+    int n = atoi(argv[2]);
+    if (n < 1) {
+        cout << "Invalid stop count.\n";
+        return 1;
+    }
+    cout.setf(ios::fixed);
+    cout.precision(2);
+    if (argc >= 4) {
+        mt19937 rng(224);
+        int start[2];
+        vector<int> flat;
+        if (!makeBenchLayout(argv[3], 1, rng, start, flat)) {
+            cout << "Unknown layout: " << argv[3] << "\n";
+            return 1;
         }
-        default:
-            cout << "Invalid choice.\n";
-            break;
+        return benchLargeLayout(argv[3], n) ? 0 : 1;
+    }
+    bool allValid = true;
+    for (size_t i = 0; i < sizeof(layouts) / sizeof(layouts[0]); ++i) {
+        allValid = benchLargeLayout(layouts[i], n) && allValid;
+    }
+    return allValid ? 0 : 1;
+}
+
+// Server stopped by SIGINT/SIGTERM in "--serve" mode
+DepotServer* activeServer = nullptr;
+
+void stopServerOnSignal(int) {
+    if (activeServer) activeServer->stop();
+}
+
+// Runs "--serve <socket> [input] [workers]": Depot query daemon.
+int runServeMode(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "Usage: " << argv[0] << " --serve <socket> [input] [workers]\n";
+        return 1;
+    }
+    string input = (argc >= 4) ? argv[3] : "DroneInput.txt";
+    int workers = (argc >= 5) ? atoi(argv[4]) : static_cast<int>(thread::hardware_concurrency());
+
+    Depot depot;
+    loadDronesFromFile(depot, input, numeric_limits<int>::max());
+    cout << "Loaded " << depot.getNumDrones() << " drones from " << input << ".\n";
+
+    DepotServer server(depot, argv[2], workers);
+    activeServer = &server;
+    signal(SIGINT, stopServerOnSignal);
+    signal(SIGTERM, stopServerOnSignal);
+    cout << "Serving on " << argv[2] << " (Ctrl+C to stop).\n";
+    bool ok = server.run();
+    activeServer = nullptr;
+    cout << "Server stopped.\n";
+    return ok ? 0 : 1;
+}
+
+// Runs "--replay <trace> [input] [--paced]": re-executes a recorded session
+// and reports per-option latency. Without --paced it runs back to back.
+int runReplayMode(int argc, char* argv[]) {
+    if (argc < 3) {
+        cout << "Usage: " << argv[0] << " --replay <trace> [input] [--paced]\n";
+        return 1;
+    }
+    string input = "DroneInput.txt";
+    bool paced = false;
+    for (int i = 3; i < argc; ++i) {
+        if (string(argv[i]) == "--paced") paced = true;
+        else input = argv[i];
+    }
+    ifstream trace(argv[2]);
+    if (!trace.is_open()) {
+        cout << "Error: Could not open " << argv[2] << endl;
+        return 1;
+    }
+    vector<TraceRecord> records;
+    TraceRecord record;
+    while (readTraceRecord(trace, record)) records.push_back(record);
+
+    // Same fleet as the recorded session: the menu loads 10 drones from
+    // DroneInput.txt, any other input is loaded whole
+    Depot depot;
+    loadDronesFromFile(depot, input, input == "DroneInput.txt" ? 10 : numeric_limits<int>::max());
+    cout << "Loaded " << depot.getNumDrones() << " drones from " << input << ".\n";
+    cout << "Replaying " << records.size() << " operations" << (paced ? " at recorded pacing" : "") << ".\n";
+    RouteJobQueue routeJobs(routeJobWorkers());
+
+    map<int, vector<double> > replayMicros, recordedMicros;
+    DiscardBuffer discard;
+    streambuf* console = cout.rdbuf();
+    auto replayStart = chrono::steady_clock::now();
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (paced) {
+            this_thread::sleep_until(replayStart + chrono::microseconds(records[i].offsetMicros));
         }
+        istringstream args(records[i].args);
+        cout.rdbuf(&discard);               // menu prompts and results are not timed output
+        auto t0 = chrono::steady_clock::now();
+        executeMenuOption(depot, routeJobs, records[i].option, args);
+        auto t1 = chrono::steady_clock::now();
+        cout.rdbuf(console);
+        replayMicros[records[i].option].push_back(chrono::duration<double, micro>(t1 - t0).count());
+        recordedMicros[records[i].option].push_back(static_cast<double>(records[i].serviceMicros));
+    }
+    double wallSeconds = chrono::duration<double>(chrono::steady_clock::now() - replayStart).count();
+    printReplayReport(replayMicros, recordedMicros, wallSeconds, cout);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && string(argv[1]) == "--stream") {
+        return runStreamMode(argc, argv);
+    }
+    if (argc >= 2 && string(argv[1]) == "--bench-exact") {
+        return runBenchExactMode(argc, argv);
+    }
+    if (argc >= 2 && string(argv[1]) == "--report") {
+        return runReportMode(argc, argv);
+    }
+    if (argc >= 2 && string(argv[1]) == "--bench-kernels") {
+        return runBenchKernelsMode();
+    }
+    if (argc >= 2 && string(argv[1]) == "--bench-large") {
+        return runBenchLargeMode(argc, argv);
+    }
+    if (argc >= 2 && string(argv[1]) == "--serve") {
+        return runServeMode(argc, argv);
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--replay") {
+        return runReplayMode(argc, argv);
+    }
+    if (argc >= 3 && string(argv[1]) == "--memory-report") {
+        Depot depot;
+        loadDronesFromFile(depot, argv[2], numeric_limits<int>::max());
+        depot.printMemoryReport(cout);
+        return 0;
+    }
+
+    Depot depot;
+    loadDronesFromFile(depot, "DroneInput.txt");
+    cout << "Loaded " << depot.getNumDrones() << " drones from DroneInput.txt.\n";
+    RouteJobQueue routeJobs(routeJobWorkers());
+
+    // "--record <trace>" logs every operation of this session
+    unique_ptr<TraceRecorder> recorder;
+    if (argc >= 3 && string(argv[1]) == "--record") {
+        recorder.reset(new TraceRecorder(argv[2], cin));
+        if (!recorder->isOpen()) return 1;
+        cout << "Recording session to " << argv[2] << ".\n";
+    }
+
+    int choice;
+    do {
+    displayMenu();          // show menu
+    cin >> choice;          // read user selection
+        cout << endl;
+
+        if (recorder && choice != 16) recorder->begin();
+        executeMenuOption(depot, routeJobs, choice, cin);
+        if (recorder && choice != 16) recorder->end(choice);
     } while (choice != 16);
 
+    if (recorder) {
+        cout << "Recorded " << recorder->getRecordedCount() << " operations.\n";
+    }
+
     return 0;
 }
 